@@ -0,0 +1,255 @@
+// What the benches and gen_dataset share: timing, and the seeded generator all their data comes from.
+// Include it after csv.h.
+#ifndef BENCH_COMMON_H_
+#define BENCH_COMMON_H_
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_RDTSC
+#endif
+
+#define ARRAY_LEN(array) (sizeof(array)/sizeof(*(array)))
+
+double now_secs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+// Timestamp counter ticks, which run at the nominal clock rate. 0 where there is none.
+uint64_t now_cycles(void) {
+#if defined(HAVE_RDTSC)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+size_t cpu_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (size_t)n : 1;
+}
+
+typedef enum {
+    TYPE_INT,
+    TYPE_FLOAT,
+    TYPE_DATE,
+    TYPE_STRING,
+    TYPES_COUNT,
+} Type;
+
+const char *type_names[TYPES_COUNT] = {
+    [TYPE_INT]    = "int",
+    [TYPE_FLOAT]  = "float",
+    [TYPE_DATE]   = "date",
+    [TYPE_STRING] = "string",
+};
+
+typedef enum {
+    LENGTHS_UNIFORM,    // Evenly spread between min_length and max_length
+    LENGTHS_SKEWED,     // Mostly near min_length, with a long tail up to max_length
+    LENGTHS_FIXED,      // Always min_length
+} Lengths;
+
+#define MAX_LENGTH 4096
+
+// A synthetic CSV that only depends on these fields, so the same Dataset gives the same bytes on every machine
+typedef struct {
+    uint64_t seed;
+    uint64_t size;                  // Stop after the row that crosses this many bytes,
+    uint64_t rows;                  // or after this many rows if it's not 0
+    size_t columns;
+    const Type *types;              // Type of every column, or NULL to draw them from `weights`
+    uint64_t weights[TYPES_COUNT];
+    Lengths lengths;                // Length of the strings
+    size_t min_length;
+    size_t max_length;
+    double quote_rate;              // Chance that a string has a delimiter in it, so it needs quotes
+    double escape_rate;             // Chance that a string has a quote in it, so it needs an escape
+    double newline_rate;            // Chance that a string has a newline in it
+    size_t escape_every;            // Also put a quote every this many bytes of every string, 0 for none
+    uint64_t cardinality;           // Distinct values per column, 0 for as many as there are rows
+    Csv_Config config;              // csv_default_config if it's all zero
+    bool header;                    // Start with a row of column names
+} Dataset;
+
+uint64_t splitmix64(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Uniform in [0, n), with a multiply instead of a division
+uint64_t random_below(uint64_t *state, uint64_t n) {
+    return (uint64_t)(((unsigned __int128)splitmix64(state)*n) >> 64);
+}
+
+// Uniform in [0, 1)
+double random_unit(uint64_t *state) {
+    return (splitmix64(state) >> 11)*0x1.0p-53;
+}
+
+size_t random_length(const Dataset *dataset, uint64_t *state) {
+    size_t span = dataset->max_length - dataset->min_length;
+    switch (dataset->lengths) {
+    case LENGTHS_FIXED:   return dataset->min_length;
+    case LENGTHS_UNIFORM: return dataset->min_length + random_below(state, span + 1);
+    case LENGTHS_SKEWED: {
+        double u = random_unit(state);
+        return dataset->min_length + (size_t)(u*u*u*(span + 1));
+    }
+    default: assert(0 && "unreachable");
+    }
+    return 0;
+}
+
+void write_value(Csv_Writer *writer, const Dataset *dataset, Type type, uint64_t *state) {
+    static const uint64_t powers[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+    char text[MAX_LENGTH];
+    switch (type) {
+    case TYPE_INT: {
+        // Mostly small numbers, like ids and counts; every 8th is negative
+        int64_t value = (int64_t)random_below(state, powers[1 + random_below(state, 9)]);
+        if ((splitmix64(state) & 7) == 0) value = -value;
+        csv_write_i64(writer, value);
+    } break;
+    case TYPE_FLOAT:
+        csv_write_f64(writer, (double)random_below(state, powers[2 + random_below(state, 7)])/100.0);
+        break;
+    case TYPE_DATE: {
+        // 2000-01-01 to 2029-12-28
+        uint64_t year = random_below(state, 30), month = 1 + random_below(state, 12), day = 1 + random_below(state, 28);
+        memcpy(text, "20", 2);
+        text[2] = '0' + year/10;  text[3] = '0' + year%10;  text[4] = '-';
+        text[5] = '0' + month/10; text[6] = '0' + month%10; text[7] = '-';
+        text[8] = '0' + day/10;   text[9] = '0' + day%10;
+        csv_write_item(writer, csv_sv_from_parts(text, 10));
+    } break;
+    case TYPE_STRING: {
+        size_t count = random_length(dataset, state);
+        uint64_t letters = 0;
+        for (size_t i = 0; i < count; i++, letters >>= 8) {
+            if (i%8 == 0) letters = splitmix64(state);
+            text[i] = 'a' + (letters & 0xFF)%26;
+        }
+        if (count > 0) {
+            if (random_unit(state) < dataset->quote_rate)   text[random_below(state, count)] = writer->config.col_delim;
+            if (random_unit(state) < dataset->escape_rate)  text[random_below(state, count)] = writer->config.quote;
+            if (random_unit(state) < dataset->newline_rate) text[random_below(state, count)] = writer->config.row_delim;
+        }
+        if (dataset->escape_every > 0) {
+            for (size_t i = dataset->escape_every - 1; i < count; i += dataset->escape_every) text[i] = writer->config.quote;
+        }
+        csv_write_item(writer, csv_sv_from_parts(text, count));
+    } break;
+    default:
+        assert(0 && "unreachable");
+    }
+}
+
+typedef struct {
+    Csv_Sink_Func sink;
+    void *user;
+    uint64_t written;
+} Dataset_Output;
+
+bool dataset_sink(const char *data, size_t count, void *user) {
+    Dataset_Output *output = user;
+    output->written += count;
+    return output->sink(data, count, output->user);
+}
+
+// Writes `dataset` to `sink` in blocks. Returns false if the sink failed.
+bool dataset_write(const Dataset *dataset, Csv_Sink_Func sink, void *user) {
+    assert(dataset->columns > 0);
+    assert(dataset->min_length <= dataset->max_length && dataset->max_length <= MAX_LENGTH);
+
+    // The type of every column comes from the seed alone
+    Type *types = malloc(dataset->columns*sizeof(*types));
+    assert(types != NULL && "Buy MORE RAM!! lol");
+    uint64_t state = dataset->seed;
+    if (dataset->types != NULL) {
+        memcpy(types, dataset->types, dataset->columns*sizeof(*types));
+    } else {
+        uint64_t total = 0;
+        for (Type type = 0; type < TYPES_COUNT; type++) total += dataset->weights[type];
+        assert(total > 0 && "Set `types` or `weights`");
+        for (size_t i = 0; i < dataset->columns; i++) {
+            uint64_t pick = random_below(&state, total);
+            Type type = 0;
+            while (pick >= dataset->weights[type]) pick -= dataset->weights[type++];
+            types[i] = type;
+        }
+    }
+
+    Dataset_Output output = { .sink = sink, .user = user };
+    Csv_Writer writer = {0};
+    csv_writer_init(&writer, dataset->config.col_delim != 0 ? dataset->config : csv_default_config, dataset_sink, &output);
+
+    if (dataset->header) {
+        for (size_t i = 0; i < dataset->columns; i++) {
+            char name[64];
+            int count = snprintf(name, sizeof(name), "%s_%zu", type_names[types[i]], i);
+            csv_write_item(&writer, csv_sv_from_parts(name, count));
+        }
+        csv_end_row(&writer);
+    }
+
+    uint64_t rows = 0;
+    while (dataset->rows > 0 ? rows < dataset->rows : output.written + writer.count < dataset->size) {
+        for (size_t i = 0; i < dataset->columns; i++) {
+            if (dataset->cardinality > 0) {
+                // The value is a function of the column and one of `cardinality` keys, so it repeats
+                uint64_t key = random_below(&state, dataset->cardinality);
+                uint64_t value_state = dataset->seed ^ (i*0xD6E8FEB86659FD93ULL) ^ (key*0xA0761D6478BD642FULL);
+                write_value(&writer, dataset, types[i], &value_state);
+            } else {
+                write_value(&writer, dataset, types[i], &state);
+            }
+        }
+        csv_end_row(&writer);
+        rows += 1;
+    }
+
+    bool ok = csv_writer_flush(&writer);
+    csv_writer_free(&writer);
+    free(types);
+    return ok;
+}
+
+typedef struct {
+    char *data;
+    size_t count;
+    size_t capacity;
+} Buffer;
+
+bool sink_buffer(const char *data, size_t count, void *user) {
+    Buffer *buffer = user;
+    if (buffer->count + count > buffer->capacity) {
+        buffer->capacity = (buffer->count + count)*2;
+        buffer->data = realloc(buffer->data, buffer->capacity);
+        assert(buffer->data != NULL && "Buy MORE RAM!! lol");
+    }
+    memcpy(buffer->data + buffer->count, data, count);
+    buffer->count += count;
+    return true;
+}
+
+// `dataset` in memory. Free its data when done.
+Csv_String_View make_dataset(const Dataset *dataset) {
+    Buffer buffer = {0};
+    dataset_write(dataset, sink_buffer, &buffer);
+    return csv_sv_from_parts(buffer.data, buffer.count);
+}
+
+#endif // BENCH_COMMON_H_
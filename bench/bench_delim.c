@@ -0,0 +1,85 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+#include "bench_common.h"
+
+// The byte-at-a-time loop csv_sv_chop_by_delim() used before the SIMD kernels, kept here as the baseline
+Csv_String_View chop_by_delim_scalar(Csv_String_View *sv, char delim) {
+    size_t i = 0;
+    while (i < sv->count && sv->data[i] != delim) {
+        i += 1;
+    }
+
+    Csv_String_View result = csv_sv_from_parts(sv->data, i);
+
+    if (i < sv->count) {
+        sv->count -= i + 1;
+        sv->data  += i + 1;
+    } else {
+        sv->count -= i;
+        sv->data  += i;
+    }
+
+    return result;
+}
+
+typedef Csv_String_View (*Chop_Func)(Csv_String_View *sv, char delim);
+
+double bench_rows(Csv_String_View dataset, Chop_Func chop, size_t iterations) {
+    size_t rows = 0;
+    double start = now_secs();
+    for (size_t i = 0; i < iterations; i++) {
+        Csv_String_View file = dataset;
+        while (file.count > 0) {
+            Csv_String_View row = chop(&file, '\n');
+            rows += row.count > 0;
+        }
+    }
+    double elapsed = now_secs() - start;
+    // Keep the loop from being optimized away
+    if (rows == 0) printf("no rows?\n");
+    return (double)dataset.count*iterations/elapsed/1e9;
+}
+
+int main(void) {
+    const size_t size = 64*1024*1024;
+    const size_t iterations = 8;
+
+    // Set CSV_SIMD=sse2 (or avx2) to compare with narrower kernels than the CPU has
+    printf("SIMD kernels: %s\n", csv_simd_name());
+    struct {
+        const char *name;
+        size_t row_len;
+    } shapes[] = {
+        { "narrow", 16 },
+        { "medium", 128 },
+        { "wide",   4096 },
+    };
+
+    for (size_t i = 0; i < ARRAY_LEN(shapes); i++) {
+        // Rows of roughly `row_len` bytes, made of 8-byte fields
+        Dataset spec = {
+            .seed = 1,
+            .size = size,
+            .columns = (shapes[i].row_len + 8)/9,
+            .weights = { [TYPE_STRING] = 1 },
+            .lengths = LENGTHS_FIXED,
+            .min_length = 8,
+            .max_length = 8,
+        };
+        Csv_String_View dataset = make_dataset(&spec);
+        double before = bench_rows(dataset, chop_by_delim_scalar, iterations);
+        double after  = bench_rows(dataset, csv_sv_chop_by_delim, iterations);
+        printf("%-8s (%5zu-byte rows): scalar %6.2f GB/s, csv_sv_chop_by_delim %6.2f GB/s (%.2fx)\n",
+               shapes[i].name, shapes[i].row_len, before, after, after/before);
+        free(dataset.data);
+    }
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+#include "bench_common.h"
+
+// CSV_FILL_STRUCT as it was before Csv_Schema: type names compared with strcmp() and the field array rebuilt on every row.
+// Kept here as the baseline.
+typedef struct {
+    size_t offset;
+    const char *type;
+} Old_Field;
+
+#define OLD_TYPE(val) _Generic((val), int: "int", float: "float", long: "long", Csv_String_View: "string_view")
+#define OLD_CSVF(field) { .offset = (size_t)&((typeof(_out))NULL)->field, .type = OLD_TYPE(_out->field) }
+#define OLD_FILL_STRUCT(row, config, out, ...) do { \
+        typeof(out) *_out = &out;               \
+        Old_Field fields[] = {__VA_ARGS__};     \
+        old_fill_struct(_out, &(row), (config), fields, ARRAY_LEN(fields)); \
+    } while(0)
+
+void old_fill_struct(void *out_v, Csv_String_View *row, Csv_Config config, const Old_Field *fields, size_t fields_count) {
+    char *out = out_v;
+    Csv_String_View item = {0};
+    for (size_t i = 0; i < fields_count && csv_next_item(row, &item, config); i++) {
+        Old_Field field = fields[i];
+        void *field_loc = out + field.offset;
+        if (strcmp(field.type, "int") == 0) {
+            int val = atoi(item.data);
+            memcpy(field_loc, &val, sizeof(val));
+        } else if (strcmp(field.type, "long") == 0) {
+            long val = atol(item.data);
+            memcpy(field_loc, &val, sizeof(val));
+        } else if (strcmp(field.type, "float") == 0) {
+            float val = (float)atof(item.data);
+            memcpy(field_loc, &val, sizeof(val));
+        } else if (strcmp(field.type, "string_view") == 0) {
+            memcpy(field_loc, &item, sizeof(Csv_String_View));
+        }
+    }
+}
+
+typedef struct {
+    float a;
+    float b;
+    float c;
+    Csv_String_View name;
+    int id;
+    long count;
+} Entry;
+
+typedef enum {
+    FILL_OLD,
+    FILL_STRUCT,
+    FILL_SCHEMA,
+} Fill_Mode;
+
+double bench_fill(Csv_String_View dataset, size_t rows, Fill_Mode mode) {
+    Csv_Schema schema = CSV_SCHEMA(Entry, CSVF(a), CSVF(b), CSVF(c), CSVF(name), CSVF(id), CSVF(count));
+    double checksum = 0;
+    double start = now_secs();
+    Csv_String_View file = dataset;
+    Csv_String_View row = {0};
+    while (csv_next_row(&file, &row, csv_default_config)) {
+        Entry entry;
+        switch (mode) {
+        case FILL_OLD:
+            OLD_FILL_STRUCT(row, csv_default_config, entry, OLD_CSVF(a), OLD_CSVF(b), OLD_CSVF(c), OLD_CSVF(name), OLD_CSVF(id), OLD_CSVF(count));
+            break;
+        case FILL_STRUCT:
+            CSV_FILL_STRUCT(row, csv_default_config, entry, CSVF(a), CSVF(b), CSVF(c), CSVF(name), CSVF(id), CSVF(count));
+            break;
+        case FILL_SCHEMA:
+            csv_schema_fill(&schema, &row, csv_default_config, &entry);
+            break;
+        }
+        checksum += entry.a + entry.id;
+    }
+    double elapsed = now_secs() - start;
+    // Keep the conversions from being optimized away
+    if (checksum == 0) printf("checksum is zero?\n");
+    return rows/elapsed/1e6;
+}
+
+int main(void) {
+    const size_t rows = 4*1000*1000;
+    // example_struct-style rows: three floats, a name, and two integers
+    static const Type types[] = { TYPE_FLOAT, TYPE_FLOAT, TYPE_FLOAT, TYPE_STRING, TYPE_INT, TYPE_INT };
+    Dataset spec = {
+        .seed = 1,
+        .rows = rows,
+        .columns = ARRAY_LEN(types),
+        .types = types,
+        .lengths = LENGTHS_UNIFORM,
+        .min_length = 4,
+        .max_length = 16,
+    };
+    Csv_String_View dataset = make_dataset(&spec);
+
+    double old = bench_fill(dataset, rows, FILL_OLD);
+    printf("strcmp dispatch (old CSV_FILL_STRUCT): %6.2f Mrows/s\n", old);
+    double fill = bench_fill(dataset, rows, FILL_STRUCT);
+    printf("CSV_FILL_STRUCT:                       %6.2f Mrows/s (%.2fx)\n", fill, fill/old);
+    double schema = bench_fill(dataset, rows, FILL_SCHEMA);
+    printf("csv_schema_fill:                       %6.2f Mrows/s (%.2fx)\n", schema, schema/old);
+
+    free(dataset.data);
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+#include "bench_common.h"
+
+typedef enum {
+    PARSE_LIBC,
+    PARSE_CSV,
+} Parse_Mode;
+
+double bench_numbers(Csv_String_View dataset, bool floats, Parse_Mode mode) {
+    double checksum = 0;
+    double start = now_secs();
+    Csv_String_View file = dataset;
+    Csv_String_View row = {0};
+    while (csv_next_row(&file, &row, csv_default_config)) {
+        if (floats) {
+            double value = 0;
+            if (mode == PARSE_LIBC) value = atof(row.data);
+            else csv_parse_f64(row, &value);
+            checksum += value;
+        } else {
+            int64_t value = 0;
+            if (mode == PARSE_LIBC) value = atoll(row.data);
+            else csv_parse_i64(row, &value);
+            checksum += value;
+        }
+    }
+    double elapsed = now_secs() - start;
+    // Keep the conversions from being optimized away
+    if (checksum == 0) printf("checksum is zero?\n");
+    return dataset.count/elapsed/1e6;
+}
+
+int main(void) {
+    const size_t rows = 8*1000*1000;
+    for (int floats = 0; floats <= 1; floats++) {
+        // One column of numbers, one per row
+        Type type = floats ? TYPE_FLOAT : TYPE_INT;
+        Dataset spec = { .seed = 1, .rows = rows, .columns = 1, .types = &type };
+        Csv_String_View dataset = make_dataset(&spec);
+        double libc = bench_numbers(dataset, floats, PARSE_LIBC);
+        double csv = bench_numbers(dataset, floats, PARSE_CSV);
+        printf("%-8s %-6s: %7.2f MB/s, %-13s: %7.2f MB/s (%.2fx)\n", floats ? "doubles" : "integers",
+               floats ? "atof" : "atoll", libc, floats ? "csv_parse_f64" : "csv_parse_i64", csv, csv/libc);
+        free(dataset.data);
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+#include "bench_common.h"
+
+#define MAX_THREADS 256
+
+typedef struct {
+    size_t rows;
+    size_t items;
+    char padding[64 - 2*sizeof(size_t)]; // Keep every thread on its own cache line
+} Counts;
+
+void count_chunk(Csv_Chunk chunk, void *user) {
+    Counts *counts = user;
+    Counts *mine = &counts[chunk.index];
+    Csv_String_View row = {0};
+    while (csv_next_row(&chunk.rows, &row, csv_default_config)) {
+        Csv_String_View item = {0};
+        while (csv_next_item(&row, &item, csv_default_config)) mine->items += 1;
+        mine->rows += 1;
+    }
+}
+
+int main(void) {
+    const size_t size = 256*1024*1024;
+    // 128-byte rows of 8-byte fields, about one of them with a quoted newline in it
+    Dataset spec = {
+        .seed = 1,
+        .size = size,
+        .columns = 15,
+        .weights = { [TYPE_STRING] = 1 },
+        .lengths = LENGTHS_FIXED,
+        .min_length = 8,
+        .max_length = 8,
+        .newline_rate = 1.0/15,
+    };
+    Csv_String_View dataset = make_dataset(&spec);
+    size_t cpus = cpu_count();
+    if (cpus > MAX_THREADS) cpus = MAX_THREADS;
+
+    static Counts counts[MAX_THREADS];
+    double single = 0;
+    for (size_t threads = 1; threads <= cpus; threads *= 2) {
+        memset(counts, 0, sizeof(counts));
+        double start = now_secs();
+        csv_parallel_chunks(dataset, csv_default_config, threads, count_chunk, counts);
+        double elapsed = now_secs() - start;
+
+        size_t rows = 0;
+        for (size_t i = 0; i < threads; i++) rows += counts[i].rows;
+        double gbs = dataset.count/elapsed/1e9;
+        if (threads == 1) single = gbs;
+        printf("csv_parallel_chunks %3zu threads: %6.2f GB/s, %zu rows (%.2fx)\n", threads, gbs, rows, gbs/single);
+        // Powers of two, then every CPU even if that isn't one
+        if (threads*2 > cpus && threads != cpus) threads = cpus/2;
+    }
+
+    free(dataset.data);
+    return 0;
+}
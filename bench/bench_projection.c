@@ -0,0 +1,71 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+#include "bench_common.h"
+
+double bench_projection(Csv_String_View dataset, const Csv_Projection *projection, bool skip) {
+    size_t kept = 0;
+    double start = now_secs();
+    Csv_String_View file = dataset;
+    Csv_String_View row = {0};
+    Csv_String_View item = {0};
+    while (csv_next_row(&file, &row, csv_default_config)) {
+        if (skip) {
+            size_t cursor = 0;
+            while (csv_next_projected_item(&row, projection, &cursor, &item, csv_default_config)) kept += item.count;
+        } else {
+            // Tokenize everything up to the last column we want
+            size_t wanted = 0;
+            for (size_t column = 0; wanted < projection->count && csv_next_item(&row, &item, csv_default_config); column++) {
+                if (column == projection->columns[wanted]) {
+                    kept += item.count;
+                    wanted += 1;
+                }
+            }
+        }
+    }
+    double elapsed = now_secs() - start;
+    // Keep the loop from being optimized away
+    if (kept == 0) printf("nothing kept?\n");
+    return dataset.count/elapsed/1e9;
+}
+
+int main(void) {
+    const size_t size = 256*1024*1024;
+    const size_t wide[] = { 5, 100, 195 };
+    const size_t narrow[] = { 0, 2 };
+    struct {
+        const char *name;
+        size_t columns;
+        Csv_Projection projection;
+    } shapes[] = {
+        { "3 of 200", 200, { wide,   ARRAY_LEN(wide) } },
+        { "2 of 4",   4,   { narrow, ARRAY_LEN(narrow) } },
+    };
+
+    for (size_t i = 0; i < ARRAY_LEN(shapes); i++) {
+        // Rows of `columns` fields of 7 letters each
+        Dataset spec = {
+            .seed = 1,
+            .size = size,
+            .columns = shapes[i].columns,
+            .weights = { [TYPE_STRING] = 1 },
+            .lengths = LENGTHS_FIXED,
+            .min_length = 7,
+            .max_length = 7,
+        };
+        Csv_String_View dataset = make_dataset(&spec);
+        double before = bench_projection(dataset, &shapes[i].projection, false);
+        double after  = bench_projection(dataset, &shapes[i].projection, true);
+        printf("%-8s columns: csv_next_item %6.2f GB/s, csv_next_projected_item %6.2f GB/s (%.2fx)\n",
+               shapes[i].name, before, after, after/before);
+        free(dataset.data);
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+#include "bench_common.h"
+
+int main(void) {
+    const size_t rows = 16*1000*1000;
+    const char *csv_path = "build/bench_row_index.csv";
+    const char *sidecar_path = "build/bench_row_index.csv.idx";
+    // A few short columns, about every 16th row with a quoted newline
+    static const Type types[] = { TYPE_INT, TYPE_STRING, TYPE_FLOAT };
+    Dataset spec = {
+        .seed = 1,
+        .rows = rows,
+        .columns = ARRAY_LEN(types),
+        .types = types,
+        .lengths = LENGTHS_UNIFORM,
+        .min_length = 4,
+        .max_length = 16,
+        .newline_rate = 1.0/16,
+    };
+    Csv_String_View dataset = make_dataset(&spec);
+
+    // The sidecar is stamped with the file it was built for, so the dataset has to be a real file
+    FILE *f = fopen(csv_path, "wb");
+    assert(f != NULL && "Could not write the dataset");
+    fwrite(dataset.data, 1, dataset.count, f);
+    fclose(f);
+
+    Csv_Row_Index index = {0};
+    bool stamped = csv_row_index_stamp(&index, csv_path);
+    assert(stamped);
+    double start = now_secs();
+    csv_row_index_build(&index, dataset, csv_default_config, 0, 0);
+    double build = now_secs() - start;
+    assert(index.rows == rows);
+    bool saved = csv_row_index_save(&index, sidecar_path, csv_path);
+    assert(saved);
+    csv_row_index_free(&index);
+
+    start = now_secs();
+    bool loaded = csv_row_index_load(&index, sidecar_path, csv_path, csv_default_config);
+    double load = now_secs() - start;
+    assert(loaded);
+
+    f = fopen(sidecar_path, "rb");
+    fseek(f, 0, SEEK_END);
+    long sidecar_size = ftell(f);
+    fclose(f);
+    printf("build: %.2f GB/s, sidecar: %ld bytes for %zu rows (%.2f bytes per indexed row), load: %.3f ms\n",
+           dataset.count/build/1e9, sidecar_size, rows, (double)sidecar_size/index.count, load*1e3);
+
+    // Getting to a row near the end, the old way and through the index
+    const size_t target = rows - 12345;
+    start = now_secs();
+    Csv_String_View file = dataset;
+    Csv_String_View row = {0};
+    for (size_t i = 0; i <= target; i++) csv_next_row(&file, &row, csv_default_config);
+    double scan = now_secs() - start;
+
+    const size_t seeks = 100000;
+    size_t checksum = 0;
+    Csv_String_View found = {0};
+    start = now_secs();
+    for (size_t i = 0; i < seeks; i++) {
+        csv_row_index_seek(&index, dataset, target - i%1000, 1, &found);
+        checksum += found.count;
+    }
+    double seek = (now_secs() - start)/seeks;
+    if (checksum == 0) printf("nothing found?\n");
+    csv_row_index_seek(&index, dataset, target, 1, &found);
+    assert(found.data == row.data);
+    printf("row %zu: csv_next_row loop %.2f ms, csv_row_index_seek %.2f us (%.0fx)\n",
+           target, scan*1e3, seek*1e6, scan/seek);
+
+    csv_row_index_free(&index);
+    free(dataset.data);
+    remove(csv_path);
+    remove(sidecar_path);
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+#include "bench_common.h"
+
+int main(void) {
+    const size_t size = 64*1024*1024;
+    const size_t iterations = 8;
+    const size_t row_lens[] = { 16, 128, 4096 };
+
+    // Set CSV_SIMD=sse2 (or avx2) to compare with narrower kernels than the CPU has
+    printf("SIMD kernels: %s\n", csv_simd_name());
+
+    for (size_t i = 0; i < ARRAY_LEN(row_lens); i++) {
+        for (int quoted = 0; quoted <= 1; quoted++) {
+            // Rows of roughly `row_len` bytes, made of 8-byte fields.
+            // With `quoted` about one field per row has a newline in it, so the quote tracking actually matters.
+            size_t columns = (row_lens[i] + 8)/9;
+            Dataset spec = {
+                .seed = 1,
+                .size = size,
+                .columns = columns,
+                .weights = { [TYPE_STRING] = 1 },
+                .lengths = LENGTHS_FIXED,
+                .min_length = 8,
+                .max_length = 8,
+                .newline_rate = quoted ? 1.0/columns : 0,
+            };
+            Csv_String_View dataset = make_dataset(&spec);
+            size_t rows = 0;
+            double start = now_secs();
+            for (size_t j = 0; j < iterations; j++) {
+                Csv_String_View file = dataset;
+                Csv_String_View row = {0};
+                while (csv_next_row(&file, &row, csv_default_config)) rows += 1;
+            }
+            double elapsed = now_secs() - start;
+            printf("csv_next_row    %5zu-byte rows, %-15s: %6.2f GB/s, %7.2f Mrows/s\n",
+                   row_lens[i], quoted ? "quoted newlines" : "plain",
+                   (double)dataset.count*iterations/elapsed/1e9, rows/elapsed/1e6);
+
+            size_t specialized_rows = 0;
+            start = now_secs();
+            for (size_t j = 0; j < iterations; j++) {
+                Csv_String_View file = dataset;
+                Csv_String_View row = {0};
+                while (csv_comma_next_row(&file, &row)) specialized_rows += 1;
+            }
+            elapsed = now_secs() - start;
+            printf("  ...csv_comma_ %5zu-byte rows, %-15s: %6.2f GB/s, %7.2f Mrows/s\n",
+                   row_lens[i], quoted ? "quoted newlines" : "plain",
+                   (double)dataset.count*iterations/elapsed/1e9, specialized_rows/elapsed/1e6);
+            assert(specialized_rows == rows);
+
+            // Items of rows that were split beforehand, so only the item splitting is timed
+            Csv_String_View *split = malloc(rows/iterations*sizeof(*split));
+            assert(split != NULL && "Buy MORE RAM!! lol");
+            Csv_String_View file = dataset;
+            for (size_t j = 0; csv_next_row(&file, &split[j], csv_default_config); j++) {}
+            size_t items = 0;
+            start = now_secs();
+            for (size_t j = 0; j < rows/iterations; j++) {
+                Csv_String_View row = split[j];
+                Csv_String_View item = {0};
+                while (csv_next_item(&row, &item, csv_default_config)) items += 1;
+            }
+            elapsed = now_secs() - start;
+            printf("csv_next_item   %5zu-byte rows, %-15s: %6.2f GB/s, %7.2f Mitems/s\n",
+                   row_lens[i], quoted ? "quoted newlines" : "plain",
+                   (double)dataset.count/elapsed/1e9, items/elapsed/1e6);
+
+            size_t specialized_items = 0;
+            start = now_secs();
+            for (size_t j = 0; j < rows/iterations; j++) {
+                Csv_String_View row = split[j];
+                Csv_String_View item = {0};
+                while (csv_comma_next_item(&row, &item)) specialized_items += 1;
+            }
+            elapsed = now_secs() - start;
+            printf("  ...csv_comma_ %5zu-byte rows, %-15s: %6.2f GB/s, %7.2f Mitems/s\n",
+                   row_lens[i], quoted ? "quoted newlines" : "plain",
+                   (double)dataset.count/elapsed/1e9, specialized_items/elapsed/1e6);
+            assert(specialized_items == items);
+            free(split);
+
+            Csv_Index index = {0};
+            start = now_secs();
+            for (size_t j = 0; j < iterations; j++) {
+                csv_index_build(&index, dataset, csv_default_config);
+            }
+            elapsed = now_secs() - start;
+            printf("csv_index_build %5zu-byte rows, %-15s: %6.2f GB/s, %7.2f Mitems/s\n",
+                   row_lens[i], quoted ? "quoted newlines" : "plain",
+                   (double)dataset.count*iterations/elapsed/1e9, index.ends.count*iterations/elapsed/1e6);
+            csv_index_free(&index);
+
+            size_t counted = 0;
+            start = now_secs();
+            for (size_t j = 0; j < iterations; j++) {
+                counted += csv_count_rows(dataset, csv_default_config);
+            }
+            elapsed = now_secs() - start;
+            printf("csv_count_rows  %5zu-byte rows, %-15s: %6.2f GB/s, %7.2f Mrows/s\n",
+                   row_lens[i], quoted ? "quoted newlines" : "plain",
+                   (double)dataset.count*iterations/elapsed/1e9, counted/elapsed/1e6);
+            assert(counted == rows);
+
+            counted = 0;
+            start = now_secs();
+            for (size_t j = 0; j < iterations; j++) {
+                counted += csv_count_rows_parallel(dataset, csv_default_config, 0);
+            }
+            elapsed = now_secs() - start;
+            printf("  ...parallel   %5zu-byte rows, %-15s: %6.2f GB/s, %7.2f Mrows/s\n",
+                   row_lens[i], quoted ? "quoted newlines" : "plain",
+                   (double)dataset.count*iterations/elapsed/1e9, counted/elapsed/1e6);
+            assert(counted == rows);
+            free(dataset.data);
+        }
+    }
+
+    return 0;
+}
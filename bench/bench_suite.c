@@ -0,0 +1,272 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+#include "bench_common.h"
+
+// Every parser path on every dataset shape, with the results also written as CSV so runs on different commits can be
+// compared: ./build/bench_suite [results.csv] [label]
+
+typedef enum {
+    NARROW_NUMERIC, // A few short integer and float columns
+    WIDE_STRING,    // 64 columns of plain words
+    QUOTE_HEAVY,    // Every item quoted, with delimiters and newlines inside
+    ESCAPE_HEAVY,   // Every item quoted, with an escaped quote every few bytes
+    LONG_LINE,      // Rows of about 64 KiB
+    SHAPES_COUNT,
+} Shape;
+
+const char *shape_names[SHAPES_COUNT] = {
+    [NARROW_NUMERIC] = "narrow_numeric",
+    [WIDE_STRING]    = "wide_string",
+    [QUOTE_HEAVY]    = "quote_heavy",
+    [ESCAPE_HEAVY]   = "escape_heavy",
+    [LONG_LINE]      = "long_line",
+};
+
+// About `size` bytes of `shape` rows, the same every run
+Dataset shape_dataset(Shape shape, size_t size) {
+    Dataset dataset = { .seed = 1, .size = size, .weights = { [TYPE_STRING] = 1 }, .lengths = LENGTHS_UNIFORM };
+    switch (shape) {
+    case NARROW_NUMERIC: {
+        static const Type types[] = { TYPE_INT, TYPE_INT, TYPE_FLOAT, TYPE_FLOAT };
+        dataset.columns = ARRAY_LEN(types);
+        dataset.types = types;
+    } break;
+    case WIDE_STRING:
+        dataset.columns = 64;
+        dataset.min_length = 4;
+        dataset.max_length = 15;
+        break;
+    case QUOTE_HEAVY:
+        dataset.columns = 8;
+        dataset.min_length = 8;
+        dataset.max_length = 31;
+        dataset.quote_rate = 1;
+        dataset.newline_rate = 1;
+        break;
+    case ESCAPE_HEAVY:
+        dataset.columns = 8;
+        dataset.min_length = 16;
+        dataset.max_length = 63;
+        dataset.escape_every = 6;
+        break;
+    case LONG_LINE:
+        dataset.columns = 4096;
+        dataset.min_length = 8;
+        dataset.max_length = 23;
+        break;
+    default:
+        assert(0 && "unreachable");
+    }
+    return dataset;
+}
+
+typedef struct {
+    int a;
+    long b;
+    float c;
+    Csv_String_View d;
+} Record;
+
+typedef struct {
+    size_t rows;
+    size_t items;
+    char padding[64 - 2*sizeof(size_t)]; // Keep every thread on its own cache line
+} Counts;
+
+#define MAX_THREADS 256
+
+void count_chunk(Csv_Chunk chunk, void *user) {
+    Counts *mine = &((Counts *)user)[chunk.index];
+    Csv_String_View row = {0};
+    while (csv_next_row(&chunk.rows, &row, csv_default_config)) {
+        Csv_String_View item = {0};
+        while (csv_next_item(&row, &item, csv_default_config)) mine->items += 1;
+        mine->rows += 1;
+    }
+}
+
+void count_row(void *state, Csv_String_View row, void *user) {
+    (void)user;
+    Counts *counts = state;
+    Csv_String_View item = {0};
+    while (csv_next_item(&row, &item, csv_default_config)) counts->items += 1;
+    counts->rows += 1;
+}
+
+void merge_counts(void *into, void *from, void *user) {
+    (void)user;
+    ((Counts *)into)->rows += ((Counts *)from)->rows;
+    ((Counts *)into)->items += ((Counts *)from)->items;
+}
+
+typedef enum {
+    BENCH_ROWS,             // csv_next_row
+    BENCH_ITEMS,            // csv_next_row + csv_next_item
+    BENCH_FILL_STRUCT,      // csv_next_row + CSV_FILL_STRUCT of the first four items
+    BENCH_COUNT_ROWS,       // csv_count_rows
+    BENCH_PARALLEL_ITEMS,   // csv_parallel_chunks + csv_next_row + csv_next_item on every core
+    BENCH_PARALLEL_COUNT,   // csv_count_rows_parallel on every core
+    BENCH_PARALLEL_REDUCE,  // csv_parallel_reduce + csv_next_item on every core
+    BENCHES_COUNT,
+} Bench;
+
+const char *bench_names[BENCHES_COUNT] = {
+    [BENCH_ROWS]            = "rows",
+    [BENCH_ITEMS]           = "items",
+    [BENCH_FILL_STRUCT]     = "fill_struct",
+    [BENCH_COUNT_ROWS]      = "count_rows",
+    [BENCH_PARALLEL_ITEMS]  = "parallel_items",
+    [BENCH_PARALLEL_COUNT]  = "parallel_count_rows",
+    [BENCH_PARALLEL_REDUCE] = "parallel_reduce",
+};
+
+// Runs `bench` once over `dataset` and returns how many rows it saw. The checksum keeps the work from being optimized away.
+size_t run_bench(Bench bench, Csv_String_View dataset, size_t *checksum) {
+    Csv_String_View file = dataset;
+    Csv_String_View row = {0};
+    size_t rows = 0;
+    switch (bench) {
+    case BENCH_ROWS:
+        while (csv_next_row(&file, &row, csv_default_config)) {
+            *checksum += row.count;
+            rows += 1;
+        }
+        break;
+    case BENCH_ITEMS:
+        while (csv_next_row(&file, &row, csv_default_config)) {
+            Csv_String_View item = {0};
+            while (csv_next_item(&row, &item, csv_default_config)) *checksum += item.count;
+            rows += 1;
+        }
+        break;
+    case BENCH_FILL_STRUCT:
+        while (csv_next_row(&file, &row, csv_default_config)) {
+            Record record = {0};
+            CSV_FILL_STRUCT(row, csv_default_config, record, CSVF(a), CSVF(b), CSVF(c), CSVF(d));
+            *checksum += record.a + record.b + (size_t)record.c + record.d.count;
+            rows += 1;
+        }
+        break;
+    case BENCH_COUNT_ROWS:
+        rows = csv_count_rows(dataset, csv_default_config);
+        break;
+    case BENCH_PARALLEL_ITEMS: {
+        static Counts counts[MAX_THREADS];
+        memset(counts, 0, sizeof(counts));
+        size_t threads = cpu_count() < MAX_THREADS ? cpu_count() : MAX_THREADS;
+        csv_parallel_chunks(dataset, csv_default_config, threads, count_chunk, counts);
+        for (size_t i = 0; i < threads; i++) {
+            rows += counts[i].rows;
+            *checksum += counts[i].items;
+        }
+    } break;
+    case BENCH_PARALLEL_COUNT:
+        rows = csv_count_rows_parallel(dataset, csv_default_config, 0);
+        break;
+    case BENCH_PARALLEL_REDUCE: {
+        Csv_Reducer reducer = { .state_size = sizeof(Counts), .row = count_row, .merge = merge_counts };
+        Counts counts;
+        csv_parallel_reduce(dataset, csv_default_config, 0, &reducer, &counts, NULL);
+        rows = counts.rows;
+        *checksum += counts.items;
+    } break;
+    default:
+        assert(0 && "unreachable");
+    }
+    return rows;
+}
+
+int main(int argc, char **argv) {
+    const char *results_path = argc > 1 ? argv[1] : "build/bench_suite.csv";
+    const char *label = argc > 2 ? argv[2] : "";
+    const size_t size = 64*1024*1024;
+    const size_t runs = 3;
+
+    FILE *results = fopen(results_path, "wb");
+    if (results == NULL) {
+        fprintf(stderr, "Could not open %s\n", results_path);
+        return 1;
+    }
+    Csv_Writer writer = {0};
+    csv_writer_init(&writer, csv_default_config, csv_sink_file, results);
+    const char *columns[] = {
+        "label", "benchmark", "dataset", "simd", "threads", "bytes", "rows", "seconds", "gb_per_s", "rows_per_s", "cycles_per_byte",
+    };
+    for (size_t i = 0; i < ARRAY_LEN(columns); i++) {
+        csv_write_item(&writer, csv_sv_from_parts((char *)columns[i], strlen(columns[i])));
+    }
+    csv_end_row(&writer);
+
+    printf("SIMD kernels: %s, %zu threads for the parallel benchmarks, best of %zu runs\n", csv_simd_name(), cpu_count(), runs);
+    size_t checksum = 0;
+    for (Shape shape = 0; shape < SHAPES_COUNT; shape++) {
+        Dataset spec = shape_dataset(shape, size);
+        Csv_String_View dataset = make_dataset(&spec);
+        size_t expected_rows = csv_count_rows(dataset, csv_default_config);
+        for (Bench bench = 0; bench < BENCHES_COUNT; bench++) {
+            double best = 0;
+            uint64_t best_cycles = 0;
+            size_t rows = 0;
+            for (size_t run = 0; run < runs; run++) {
+                double start = now_secs();
+                uint64_t start_cycles = now_cycles();
+                rows = run_bench(bench, dataset, &checksum);
+                uint64_t cycles = now_cycles() - start_cycles;
+                double elapsed = now_secs() - start;
+                if (run == 0 || elapsed < best) {
+                    best = elapsed;
+                    best_cycles = cycles;
+                }
+            }
+            assert(rows == expected_rows);
+
+            bool parallel = bench == BENCH_PARALLEL_ITEMS || bench == BENCH_PARALLEL_COUNT || bench == BENCH_PARALLEL_REDUCE;
+            double gbs = dataset.count/best/1e9;
+            double rows_per_s = rows/best;
+            double cycles_per_byte = (double)best_cycles/dataset.count;
+            printf("%-14s %-19s: %6.2f GB/s, %8.2f Mrows/s, %6.2f cycles/byte\n",
+                   shape_names[shape], bench_names[bench], gbs, rows_per_s/1e6, cycles_per_byte);
+
+            const char *texts[] = { label, bench_names[bench], shape_names[shape], csv_simd_name() };
+            for (size_t i = 0; i < ARRAY_LEN(texts); i++) {
+                csv_write_item(&writer, csv_sv_from_parts((char *)texts[i], strlen(texts[i])));
+            }
+            csv_write_i64(&writer, parallel ? (int64_t)cpu_count() : 1);
+            csv_write_i64(&writer, (int64_t)dataset.count);
+            csv_write_i64(&writer, (int64_t)rows);
+            csv_write_f64(&writer, best);
+            csv_write_f64(&writer, gbs);
+            csv_write_f64(&writer, rows_per_s);
+            csv_write_f64(&writer, cycles_per_byte);
+            csv_end_row(&writer);
+        }
+#if defined(CSV_STATS)
+        // What one pass of item splitting ran into, e.g. `./nob bench -DCSV_STATS_TIMING`
+        *csv_stats() = (Csv_Stats) {0};
+        run_bench(BENCH_ITEMS, dataset, &checksum);
+        Csv_Stats *stats = csv_stats();
+        printf("%-14s stats: %llu items, %llu quoted, %llu escapes, longest row %llu bytes, rows %.0f ms, items %.0f ms\n",
+               shape_names[shape], (unsigned long long)stats->items, (unsigned long long)stats->quoted_items,
+               (unsigned long long)stats->escapes, (unsigned long long)stats->max_row_length, stats->row_ns/1e6, stats->item_ns/1e6);
+#endif // CSV_STATS
+        free(dataset.data);
+    }
+
+    bool ok = csv_writer_flush(&writer);
+    csv_writer_free(&writer);
+    fclose(results);
+    if (!ok) {
+        fprintf(stderr, "Could not write %s\n", results_path);
+        return 1;
+    }
+    if (checksum == 0) printf("checksum is zero?\n");
+    printf("Results written to %s\n", results_path);
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+#include "bench_common.h"
+
+// The byte-at-a-time loop, kept here as the baseline
+size_t unescape_scalar(char *out, Csv_String_View sv, char escape) {
+    size_t written = 0;
+    for (size_t i = 0; i < sv.count; i++) {
+        if (sv.data[i] == escape && i + 1 < sv.count) i += 1;
+        out[written++] = sv.data[i];
+    }
+    return written;
+}
+
+double bench_unescape(Csv_String_View dataset, Csv_Config config, bool scalar) {
+    char *out = malloc(dataset.count);
+    assert(out != NULL && "Buy MORE RAM!! lol");
+    Csv_Arena arena = {0};
+    size_t written = 0;
+
+    // Split first so only the unescaping is timed
+    Csv_Item *items = malloc(dataset.count/4*sizeof(*items));
+    assert(items != NULL && "Buy MORE RAM!! lol");
+    size_t items_count = 0;
+    Csv_String_View file = dataset;
+    Csv_String_View row = {0};
+    while (csv_next_row(&file, &row, config)) {
+        csv_next_item_ex(&row, &items[items_count++], config);
+    }
+
+    double start = now_secs();
+    for (size_t i = 0; i < items_count; i++) {
+        if (scalar) {
+            written += unescape_scalar(out, items[i].view, config.escape);
+        } else {
+            written += csv_unescape(&arena, items[i], config).count;
+            if (i%1024 == 1023) csv_arena_reset(&arena);
+        }
+    }
+    double elapsed = now_secs() - start;
+    // Keep the copies from being optimized away
+    if (written == 0) printf("nothing written?\n");
+
+    free(items);
+    free(out);
+    csv_arena_free(&arena);
+    return dataset.count/elapsed/1e9;
+}
+
+int main(void) {
+    const size_t size = 64*1024*1024;
+    struct {
+        const char *name;
+        Csv_Config config;
+    } dialects[] = {
+        { "backslash", csv_default_config },
+        { "doubled",   csv_rfc4180_config },
+    };
+    struct {
+        size_t item_len;
+        size_t every;
+    } shapes[] = {
+        { 32,   8 },
+        { 256,  16 },
+        { 4096, 64 },
+    };
+
+    for (size_t d = 0; d < ARRAY_LEN(dialects); d++) {
+        for (size_t i = 0; i < ARRAY_LEN(shapes); i++) {
+            // Rows of one quoted item of `item_len` bytes, with an escaped quote every `every` bytes
+            Dataset spec = {
+                .seed = 1,
+                .size = size,
+                .columns = 1,
+                .weights = { [TYPE_STRING] = 1 },
+                .lengths = LENGTHS_FIXED,
+                .min_length = shapes[i].item_len,
+                .max_length = shapes[i].item_len,
+                .escape_every = shapes[i].every,
+                .config = dialects[d].config,
+            };
+            Csv_String_View dataset = make_dataset(&spec);
+            double before = bench_unescape(dataset, dialects[d].config, true);
+            double after  = bench_unescape(dataset, dialects[d].config, false);
+            printf("%-9s (%4zu-byte items, escape every %2zu): scalar %6.2f GB/s, csv_unescape %6.2f GB/s (%.2fx)\n",
+                   dialects[d].name, shapes[i].item_len, shapes[i].every, before, after, after/before);
+            free(dataset.data);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,181 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+#include "bench_common.h"
+
+typedef struct {
+    int64_t id;
+    double price;
+    const char *name;
+} Row;
+
+// Ids, prices with a few decimals, and names of which every 8th needs quotes
+Row *make_rows(size_t count) {
+    static const char *names[] = {
+        "apple", "banana", "cherry", "durian", "elderberry", "fig", "grape",
+        "Smith, John \"Johnny\"",
+    };
+    Row *rows = malloc(count*sizeof(*rows));
+    assert(rows != NULL && "Buy MORE RAM!! lol");
+    uint64_t x = 88172645463325252ULL;
+    for (size_t i = 0; i < count; i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        rows[i].id = (int64_t)(x%10000000000ULL) - 5000000000LL;
+        rows[i].price = (double)(x%10000000)/100.0;
+        rows[i].name = names[i%8];
+    }
+    return rows;
+}
+
+typedef struct {
+    char *data;
+    size_t count;
+    size_t capacity;
+} Memory;
+
+bool sink_memory(const char *data, size_t count, void *user) {
+    Memory *memory = user;
+    if (memory->count + count > memory->capacity) return false;
+    memcpy(memory->data + memory->count, data, count);
+    memory->count += count;
+    return true;
+}
+
+// The hand-rolled way: snprintf, and quotes wherever they might be needed
+double bench_snprintf(const Row *rows, size_t count, Memory *memory) {
+    memory->count = 0;
+    double start = now_secs();
+    for (size_t i = 0; i < count; i++) {
+        char *out = memory->data + memory->count;
+        size_t left = memory->capacity - memory->count;
+        memory->count += snprintf(out, left, "%lld,%.17g,\"", (long long)rows[i].id, rows[i].price);
+        for (const char *p = rows[i].name; *p != '\0'; p++) {
+            if (*p == '"' || *p == '\\') memory->data[memory->count++] = '\\';
+            memory->data[memory->count++] = *p;
+        }
+        memory->data[memory->count++] = '"';
+        memory->data[memory->count++] = '\n';
+    }
+    return now_secs() - start;
+}
+
+double bench_writer(const Row *rows, size_t count, Memory *memory) {
+    memory->count = 0;
+    Csv_Writer writer = {0};
+    csv_writer_init(&writer, csv_default_config, sink_memory, memory);
+    double start = now_secs();
+    for (size_t i = 0; i < count; i++) {
+        csv_write_i64(&writer, rows[i].id);
+        csv_write_f64(&writer, rows[i].price);
+        csv_write_item(&writer, csv_sv_from_parts((char *)rows[i].name, strlen(rows[i].name)));
+        csv_end_row(&writer);
+    }
+    bool ok = csv_writer_flush(&writer);
+    double elapsed = now_secs() - start;
+    assert(ok);
+    csv_writer_free(&writer);
+    return elapsed;
+}
+
+void format_rows(Csv_Writer *writer, size_t first, size_t count, void *user) {
+    const Row *rows = user;
+    for (size_t i = first; i < first + count; i++) {
+        csv_write_i64(writer, rows[i].id);
+        csv_write_f64(writer, rows[i].price);
+        csv_write_item(writer, csv_sv_from_parts((char *)rows[i].name, strlen(rows[i].name)));
+        csv_end_row(writer);
+    }
+}
+
+double bench_parallel_writer(const Row *rows, size_t count, Memory *memory, size_t threads) {
+    memory->count = 0;
+    Csv_Writer writer = {0};
+    csv_writer_init(&writer, csv_default_config, sink_memory, memory);
+    double start = now_secs();
+    csv_parallel_write(&writer, count, threads, format_rows, (void *)rows);
+    bool ok = csv_writer_flush(&writer);
+    double elapsed = now_secs() - start;
+    assert(ok);
+    csv_writer_free(&writer);
+    return elapsed;
+}
+
+double bench_reader(Csv_String_View dataset) {
+    size_t items = 0;
+    double start = now_secs();
+    Csv_String_View file = dataset;
+    Csv_String_View row = {0};
+    while (csv_next_row(&file, &row, csv_default_config)) {
+        Csv_String_View item = {0};
+        while (csv_next_item(&row, &item, csv_default_config)) items += 1;
+    }
+    double elapsed = now_secs() - start;
+    if (items == 0) printf("no items?\n");
+    return elapsed;
+}
+
+// Everything written has to come back the same
+void check_round_trip(const Row *rows, size_t count, Csv_String_View dataset) {
+    Csv_Arena arena = {0};
+    Csv_String_View file = dataset;
+    Csv_String_View row = {0};
+    for (size_t i = 0; i < count; i++) {
+        bool ok = csv_next_row(&file, &row, csv_default_config);
+        assert(ok);
+        Csv_Item item = {0};
+        int64_t id = 0;
+        double price = 0;
+        csv_next_item_ex(&row, &item, csv_default_config);
+        assert(csv_parse_i64(item.view, &id) == CSV_PARSE_OK && id == rows[i].id);
+        csv_next_item_ex(&row, &item, csv_default_config);
+        assert(csv_parse_f64(item.view, &price) == CSV_PARSE_OK && price == rows[i].price);
+        csv_next_item_ex(&row, &item, csv_default_config);
+        Csv_String_View name = csv_unescape(&arena, item, csv_default_config);
+        assert(name.count == strlen(rows[i].name) && memcmp(name.data, rows[i].name, name.count) == 0);
+        if (i%1024 == 1023) csv_arena_reset(&arena);
+    }
+    assert(file.count == 0);
+    csv_arena_free(&arena);
+}
+
+int main(void) {
+    const size_t count = 8*1000*1000;
+    Row *rows = make_rows(count);
+    Memory memory = { .capacity = count*64 };
+    memory.data = malloc(memory.capacity);
+    assert(memory.data != NULL && "Buy MORE RAM!! lol");
+
+    // The two write different bytes (%.17g is longer than the shortest round trip), so compare rows per second
+    double before = bench_snprintf(rows, count, &memory);
+    double after = bench_writer(rows, count, &memory);
+    Csv_String_View dataset = csv_sv_from_parts(memory.data, memory.count);
+    check_round_trip(rows, count, dataset);
+    double read = bench_reader(dataset);
+    printf("snprintf: %.2f Mrows/s, Csv_Writer: %.2f Mrows/s (%.2fx)\n", count/before/1e6, count/after/1e6, before/after);
+    printf("Csv_Writer: %.2f GB/s, reading it back: %.2f GB/s\n", dataset.count/after/1e9, dataset.count/read/1e9);
+
+    // The parallel writer has to give back the exact same bytes
+    Memory parallel = { .capacity = memory.capacity };
+    parallel.data = malloc(parallel.capacity);
+    assert(parallel.data != NULL && "Buy MORE RAM!! lol");
+    size_t threads[] = { 1, 2, 4, 8, 0 };
+    for (size_t i = 0; i < ARRAY_LEN(threads); i++) {
+        double elapsed = bench_parallel_writer(rows, count, &parallel, threads[i]);
+        assert(parallel.count == memory.count && memcmp(parallel.data, memory.data, memory.count) == 0);
+        char label[32];
+        if (threads[i] == 0) snprintf(label, sizeof(label), "all cores");
+        else snprintf(label, sizeof(label), "%zu threads", threads[i]);
+        printf("csv_parallel_write (%s): %.2f GB/s (%.2fx)\n", label, dataset.count/elapsed/1e9, after/elapsed);
+    }
+    free(parallel.data);
+
+    free(memory.data);
+    free(rows);
+    return 0;
+}
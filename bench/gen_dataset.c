@@ -0,0 +1,185 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+#include "bench_common.h"
+
+// Writes a synthetic CSV that only depends on the options, so the same command gives the same bytes on every machine.
+//
+//   ./build/gen_dataset [options] [output.csv]
+//
+//   --seed=N                 Seed (1)
+//   --size=N[K|M|G]          Stop after the row that crosses this many bytes (1G)
+//   --rows=N                 Stop after this many rows instead
+//   --columns=N              Columns per row (16)
+//   --types=T:W,...          Type mix: weights for int, float, date and string (int:4,float:2,date:1,string:3)
+//   --lengths=fixed:N        Length of the strings: always N,
+//   --lengths=uniform:A:B      evenly spread between A and B (uniform:4:16),
+//   --lengths=skewed:A:B       or mostly near A with a long tail up to B
+//   --quote-rate=P           Chance that a string has a delimiter in it, so it needs quotes (0.05)
+//   --escape-rate=P          Chance that a string has a quote in it, so it needs an escape (0.01)
+//   --newline-rate=P         Chance that a string has a newline in it (0.001)
+//   --escape-every=N         Also put a quote every N bytes of every string (0 for none)
+//   --cardinality=N          Distinct values per column, 0 for as many as there are rows (0)
+//   --rfc4180                Escape quotes by doubling them instead of with a backslash
+//   --header                 Start with a row of column names
+//
+// Without an output path the CSV goes to stdout.
+
+typedef struct {
+    Dataset dataset;
+    bool rfc4180;
+    const char *output;
+} Options;
+
+typedef struct {
+    FILE *file;
+    uint64_t written;
+} Output;
+
+bool sink_output(const char *data, size_t count, void *user) {
+    Output *output = user;
+    output->written += count;
+    return fwrite(data, 1, count, output->file) == count;
+}
+
+bool parse_u64(const char *text, uint64_t *out) {
+    char *end = NULL;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (end == text) return false;
+    switch (*end) {
+    case 'K': value <<= 10; end++; break;
+    case 'M': value <<= 20; end++; break;
+    case 'G': value <<= 30; end++; break;
+    }
+    *out = value;
+    return *end == '\0';
+}
+
+bool parse_rate(const char *text, double *out) {
+    char *end = NULL;
+    *out = strtod(text, &end);
+    return end != text && *end == '\0' && *out >= 0 && *out <= 1;
+}
+
+bool parse_types(const char *text, uint64_t weights[TYPES_COUNT]) {
+    memset(weights, 0, TYPES_COUNT*sizeof(*weights));
+    uint64_t total = 0;
+    while (*text != '\0') {
+        const char *colon = strchr(text, ':');
+        if (colon == NULL) return false;
+        Type type = 0;
+        while (type < TYPES_COUNT && !(strlen(type_names[type]) == (size_t)(colon - text) && memcmp(type_names[type], text, colon - text) == 0)) type++;
+        if (type == TYPES_COUNT) return false;
+        char *end = NULL;
+        weights[type] = strtoull(colon + 1, &end, 10);
+        if (end == colon + 1 || (*end != ',' && *end != '\0')) return false;
+        total += weights[type];
+        text = *end == ',' ? end + 1 : end;
+    }
+    return total > 0;
+}
+
+bool parse_lengths(const char *text, Dataset *options) {
+    unsigned long a = 0, b = 0;
+    if (sscanf(text, "fixed:%lu", &a) == 1) {
+        options->lengths = LENGTHS_FIXED;
+        b = a;
+    } else if (sscanf(text, "uniform:%lu:%lu", &a, &b) == 2) {
+        options->lengths = LENGTHS_UNIFORM;
+    } else if (sscanf(text, "skewed:%lu:%lu", &a, &b) == 2) {
+        options->lengths = LENGTHS_SKEWED;
+    } else {
+        return false;
+    }
+    options->min_length = a;
+    options->max_length = b;
+    return a <= b && b <= MAX_LENGTH;
+}
+
+bool parse_options(int argc, char **argv, Options *options) {
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (strncmp(arg, "--", 2) != 0) {
+            options->output = arg;
+            continue;
+        }
+        const char *equals = strchr(arg, '=');
+        const char *value = equals ? equals + 1 : "";
+        size_t name_count = equals ? (size_t)(equals - arg) : strlen(arg);
+#define IS(name) (strlen(name) == name_count && memcmp(arg, name, name_count) == 0)
+        bool ok = false;
+        Dataset *dataset = &options->dataset;
+        if      (IS("--seed"))         ok = parse_u64(value, &dataset->seed);
+        else if (IS("--size"))         ok = parse_u64(value, &dataset->size);
+        else if (IS("--rows"))         ok = parse_u64(value, &dataset->rows);
+        else if (IS("--cardinality"))  ok = parse_u64(value, &dataset->cardinality);
+        else if (IS("--types"))        ok = parse_types(value, dataset->weights);
+        else if (IS("--lengths"))      ok = parse_lengths(value, dataset);
+        else if (IS("--quote-rate"))   ok = parse_rate(value, &dataset->quote_rate);
+        else if (IS("--escape-rate"))  ok = parse_rate(value, &dataset->escape_rate);
+        else if (IS("--newline-rate")) ok = parse_rate(value, &dataset->newline_rate);
+        else if (IS("--rfc4180"))      ok = options->rfc4180 = true;
+        else if (IS("--header"))       ok = dataset->header = true;
+        else if (IS("--columns") || IS("--escape-every")) {
+            uint64_t n = 0;
+            ok = parse_u64(value, &n);
+            if (IS("--columns")) {
+                ok = ok && n > 0;
+                dataset->columns = n;
+            } else {
+                dataset->escape_every = n;
+            }
+        }
+#undef IS
+        if (!ok) {
+            fprintf(stderr, "Bad option: %s\n", arg);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    Options options = {
+        .dataset = {
+            .seed = 1,
+            .size = 1ULL << 30,
+            .columns = 16,
+            .weights = { [TYPE_INT] = 4, [TYPE_FLOAT] = 2, [TYPE_DATE] = 1, [TYPE_STRING] = 3 },
+            .lengths = LENGTHS_UNIFORM,
+            .min_length = 4,
+            .max_length = 16,
+            .quote_rate = 0.05,
+            .escape_rate = 0.01,
+            .newline_rate = 0.001,
+        },
+    };
+    if (!parse_options(argc, argv, &options)) return 1;
+    options.dataset.config = options.rfc4180 ? csv_rfc4180_config : csv_default_config;
+
+    Output output = { .file = stdout };
+    if (options.output != NULL) {
+        output.file = fopen(options.output, "wb");
+        if (output.file == NULL) {
+            fprintf(stderr, "Could not open %s\n", options.output);
+            return 1;
+        }
+    }
+
+    double start = now_secs();
+    bool ok = dataset_write(&options.dataset, sink_output, &output);
+    if (output.file != stdout) ok = fclose(output.file) == 0 && ok;
+    if (!ok) {
+        fprintf(stderr, "Could not write %s\n", options.output ? options.output : "stdout");
+        return 1;
+    }
+    double elapsed = now_secs() - start;
+    fprintf(stderr, "%llu bytes, %.2f GB/s\n", (unsigned long long)output.written, output.written/elapsed/1e9);
+    return 0;
+}
@@ -48,6 +48,123 @@
    }
    ```
 
+   If you fill the same struct in more than one place, describe it once with `CSV_SCHEMA` and pass the schema around:
+   ```c
+   Csv_Schema user_schema = CSV_SCHEMA(User, CSVF(name), CSVF(id), CSVF(balance));
+   ...
+   User user;
+   csv_schema_fill(&user_schema, &row, csv_default_config, &user);
+   ```
+   Either way the field list is built at compile time, with each type resolved to a `Csv_Type`, so filling a row
+     only costs the conversions.
+   Both fill by position. If the file has a header row, match the columns by name instead, so reordered columns
+     still land in the right fields. `csv_schema_bind` looks up each field's name once, in a hash table built from the
+     header; after that, filling a row costs the same as by position:
+   ```c
+   Csv_Header header = {0};
+   csv_next_row(&file, &row, csv_default_config);
+   csv_header_parse(&header, row, csv_default_config);
+   Csv_Binding binding = {0};
+   if (!csv_schema_bind(&user_schema, &header, &binding)) printf("Some fields have no column\n");
+   while (csv_next_row(&file, &row, csv_default_config)) {
+       User user = {0};
+       csv_binding_fill(&binding, &row, csv_default_config, &user);
+   }
+   csv_binding_free(&binding);
+   csv_header_free(&header);
+   ```
+
+   # Projection
+   When you only need a few columns of a wide file, don't tokenize the rest. `csv_skip_items` jumps over items by
+     counting column delimiters outside of quotes in 64-byte blocks, and `csv_next_projected_item` uses it to give you
+     only the columns you asked for:
+   ```c
+   size_t columns[] = { 5, 100, 195 };
+   Csv_Projection projection = { columns, 3 };
+   while (csv_next_row(&file, &row, csv_default_config)) {
+       size_t cursor = 0;
+       Csv_String_View item = {0};
+       while (csv_next_projected_item(&row, &projection, &cursor, &item, csv_default_config)) {
+           printf("Column %zu: %.*s\n", columns[cursor - 1], (int)item.count, item.data);
+       }
+   }
+   ```
+   Bound schemas and batches skip the columns they don't use the same way.
+
+   # Filtering
+   If you only keep a few rows, check them before converting anything. A `Csv_Filter` is a list of predicates
+     (equality, prefix, or integer/float range) on columns given by position or by name, checked on the raw bytes
+     of the items:
+   ```c
+   Csv_Predicate predicates[] = {
+       { .kind = CSV_PREDICATE_EQ, .name = "status", .text = "FAILED" },
+       { .kind = CSV_PREDICATE_I64_RANGE, .column = 0, .i64 = { 1000, INT64_MAX } },
+   };
+   Csv_Filter filter = {0};
+   csv_filter_init(&filter, predicates, 2, &header);
+   while (csv_next_matching_row(&file, &row, &filter, csv_default_config)) {
+       csv_binding_fill(&binding, &row, csv_default_config, &user); // Only rows that matched get here
+   }
+   csv_filter_free(&filter);
+   ```
+   Numbers are converted with `csv_parse_i64` and `csv_parse_f64`, which you can also call yourself. They only read the
+     bytes of the item (items are not NUL-terminated), ignore the locale, and tell you about garbage and overflow.
+     Most numbers are converted exactly by Clinger's fast path, and the rest by Eisel-Lemire with a table of 128-bit
+     powers of five. Only inf, nan and some numbers past 19 digits go through strtod() switched to the "C" locale, so
+     they're slower but still always read '.' as the decimal point. Items that don't convert are filled with 0.
+
+   # Columnar batches
+   For analytics it's often better to have columns than structs. `csv_batch_read` parses up to `capacity` rows at once
+     straight into one typed array per column (`int64_t`, `double`, or string offsets + bytes), with a validity bitmap
+     marking missing or unparseable values:
+   ```c
+   Csv_Column_Type types[] = { CSV_COLUMN_I64, CSV_COLUMN_STRING };
+   size_t sources[] = { 1, 0 }; // item 1 of each row goes in column 0, item 0 in column 1
+   Csv_Batch batch = {0};
+   csv_batch_init(&batch, types, sources, 2, 4096);
+   while (csv_batch_read(&batch, &file, csv_default_config) > 0) {
+       for (size_t i = 0; i < batch.rows; i++) sum += batch.columns[0].i64[i];
+   }
+   csv_batch_free(&batch);
+   ```
+
+   Batches can be handed to anything that speaks the Arrow C Data Interface with `csv_batch_export_arrow`, which moves
+     the column buffers into an `ArrowArray` without copying. `CSV_COLUMN_STRING_VIEW` columns don't even copy the
+     strings: they are Arrow string_views pointing into the parsed buffer. See examples/example_arrow.c.
+
+   # Writing
+   `Csv_Writer` goes the other way, in the dialect of a `Csv_Config`. Output is buffered and handed to a sink function in
+     blocks of `CSV_WRITER_BUFFER_SIZE` bytes; `csv_sink_file` writes to a `FILE *`:
+   ```c
+   Csv_Writer writer = {0};
+   csv_writer_init(&writer, csv_default_config, csv_sink_file, stdout);
+   csv_write_item(&writer, name);
+   csv_write_i64(&writer, id);
+   csv_write_f64(&writer, balance);
+   csv_end_row(&writer);
+   if (!csv_writer_flush(&writer)) printf("Could not write everything\n");
+   csv_writer_free(&writer);
+   ```
+   Items are only quoted when they need it, which is found with the same 64-byte bitmasks the parser uses. An empty item
+     that ends a row is the exception: it's written as `""`, or the row would read back one item short.
+     Integers are formatted two digits at a time, and doubles with the fewest digits that `csv_parse_f64` reads back
+     as exactly the same number (Schubfach, with a quicker loop for the usual few decimals), so writing and reading
+     back is lossless.
+   When formatting is the bottleneck, `csv_parallel_write` formats batches of rows on all cores and still writes them
+     in order, so the output is byte for byte what a single thread would write:
+   ```c
+   void format_users(Csv_Writer *writer, size_t first, size_t count, void *user) {
+       const User *users = user;
+       for (size_t i = first; i < first + count; i++) {
+           csv_write_item(writer, users[i].name);
+           csv_write_i64(writer, users[i].id);
+           csv_end_row(writer);
+       }
+   }
+
+   csv_parallel_write(&writer, users_count, 0, format_users, users);
+   ```
+
    # Using a different Csv_Config
    This example parses TSV (tab-separated values) instead of CSV (comma-separated values)
    ```c
@@ -72,6 +189,18 @@
    }
    ```
 
+   If the dialect is fixed, the parser can be stamped out for it, with the delimiters as constants in the inner loops
+     instead of fields loaded from the config. `csv_comma_*` (`csv_default_config`), `csv_rfc4180_*`, `csv_tsv_*` and
+     `csv_psv_*` (pipes) come with the library, and `CSV_DEFINE_DIALECT` makes more:
+   ```c
+   CSV_DEFINE_DIALECT(semicolon, ';', '\n', '"', '"') // after #include "csv.h", in the file with CSV_IMPLEMENTATION
+
+   while (semicolon_next_row(&file, &row)) {
+       while (semicolon_next_item(&row, &item)) { ... }
+   }
+   ```
+   Other files can use them after `CSV_DECLARE_DIALECT(semicolon);`.
+
    # Using your own String_View
    You can configure csv.h to use whatever String_View you want by defining the Csv_String_View macro:
    ```c
@@ -100,6 +229,180 @@
    #include "csv.h"
    ```
 
+   # Quoted fields
+   Items starting with `config.quote` run until the matching unescaped quote, and may contain `config.col_delim` and
+     `config.row_delim`. `csv_next_row` tracks quotes 64 bytes at a time with bitmasks, so files with quoted newlines
+     are split just as fast as files without them. Quotes are only special at the start of an item, and a quoted item
+     must close right before a delimiter. Files with stray quotes in the middle of items (`ab"c`) are not supported.
+   Items are views into your buffer, so escapes are left in. `csv_next_item_ex` also tells you whether the item was
+     quoted and whether it has any escapes, and `csv_unescape` strips them into an arena only when there are some:
+   ```c
+   Csv_Arena arena = {0};
+   Csv_Item item = {0};
+   while (csv_next_item_ex(&row, &item, csv_default_config)) {
+       Csv_String_View sv = csv_unescape(&arena, item, csv_default_config); // Same view back if nothing to strip
+       printf("Item: %.*s\n", (int)sv.count, sv.data);
+   }
+   csv_arena_free(&arena);
+   ```
+   `csv_default_config` escapes with a backslash (`\"`). Files following RFC 4180 (most spreadsheet exports) double the
+     quote instead (`""`): use `csv_rfc4180_config`, or set `config.escape = config.quote` in your own config. Both
+     styles go through the same bitmask quote tracking and unescaping kernels.
+
+   # Structural index
+   `csv_index_build` scans a whole file once and records where every item ends. After that, rows and items are
+     just array lookups, in any order:
+   ```c
+   Csv_Index index = {0};
+   csv_index_build(&index, file, csv_default_config);
+   for (size_t row = 0; row < csv_index_row_count(&index); row++) {
+       for (size_t item = 0; item < csv_index_item_count(&index, row); item++) {
+           Csv_String_View sv = csv_index_item(&index, row, item, csv_default_config);
+           printf("Item: %.*s\n", (int)sv.count, sv.data);
+       }
+   }
+   csv_index_free(&index);
+   ```
+   The items are the same views `csv_next_row` and `csv_next_item` would give you.
+
+   # Reading files
+   `csv_file_open` maps a file into memory instead of copying it, so parsing starts right away and the file is never
+     in memory twice. Call `csv_file_advance` as you go and it prefetches the next `CSV_FILE_WINDOW` bytes and gives back
+     the pages you've already parsed, so even multi-GB files only take a couple of windows of RSS.
+   ```c
+   Csv_File f = {0};
+   if (!csv_file_open(&f, "data.csv")) return 1;
+   Csv_String_View file = f.data;
+   Csv_String_View row = {0};
+   while (csv_next_row(&file, &row, csv_default_config)) {
+       ...
+       csv_file_advance(&f, file.data);
+   }
+   csv_file_close(&f);
+   ```
+
+   # Streaming
+   If the input doesn't fit in memory (or just isn't all there yet), feed it to a `Csv_Stream` piece by piece.
+     Complete rows are passed to your callback; rows and quoted fields split between pieces are carried over.
+   ```c
+   void on_row(Csv_String_View row, void *user) { ... }
+
+   Csv_Stream stream = {0};
+   char buffer[64*1024];
+   ssize_t n;
+   while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+       csv_stream_feed(&stream, buffer, n, csv_default_config, on_row, NULL);
+   }
+   csv_stream_finish(&stream, on_row, NULL);
+   csv_stream_free(&stream);
+   ```
+
+   # Parallel parsing
+   `csv_parallel_chunks` splits a file into one chunk of whole rows per thread and runs your callback on all of them at
+     once. The quote state at each split point is found with a parallel pass that only counts quotes, so quoted row
+     delimiters are never mistaken for row boundaries. `csv_split_chunks` does the splitting alone if you bring your own threads.
+   ```c
+   void count_rows(Csv_Chunk chunk, void *user) {
+       size_t *counts = user;
+       Csv_String_View row = {0};
+       while (csv_next_row(&chunk.rows, &row, csv_default_config)) counts[chunk.index] += 1;
+   }
+
+   size_t counts[8] = {0};
+   csv_parallel_chunks(file, csv_default_config, 8, count_rows, counts);
+   ```
+   Most jobs parse and then aggregate, and `csv_parallel_reduce` does the threading for those. Each thread reduces its
+     chunk into a state of its own, and the states are merged in file order at the end:
+   ```c
+   typedef struct { double sum; size_t count; } Total;
+
+   void add_row(void *state, Csv_String_View row, void *user) {
+       Total *total = state;
+       Csv_String_View item = {0};
+       double price = 0;
+       csv_skip_items(&row, 2, csv_default_config);
+       if (csv_next_item(&row, &item, csv_default_config) && csv_parse_f64(item, &price) == CSV_PARSE_OK) {
+           total->sum += price;
+           total->count += 1;
+       }
+   }
+
+   void merge_totals(void *into, void *from, void *user) {
+       ((Total *)into)->sum += ((Total *)from)->sum;
+       ((Total *)into)->count += ((Total *)from)->count;
+   }
+
+   Csv_Reducer reducer = { .state_size = sizeof(Total), .row = add_row, .merge = merge_totals };
+   Total total;
+   csv_parallel_reduce(file, csv_default_config, 0, &reducer, &total, NULL);
+   ```
+   Threads use pthreads (compile with `-pthread`). Define `CSV_NO_THREADS` to run everything on the calling thread instead.
+
+   If all you need is how many rows there are (for a progress bar, or to size a buffer), `csv_count_rows` counts
+     the row delimiters outside of quotes 64 bytes at a time without making any views, and `csv_count_rows_parallel`
+     does the same on all cores in a single pass.
+
+   # Row index sidecar
+   To get to row 50,000,000 without parsing the 49,999,999 before it, build a `Csv_Row_Index` once (in parallel) and
+     save it next to the file. It only keeps where every `CSV_ROW_INDEX_STRIDE`th row starts, delta-encoded, so it's
+     a few bytes per thousand rows. Loading checks the file's size and modification time (to the nanosecond where the
+     filesystem keeps it), and saving refuses if the file changed since `csv_row_index_stamp`, which you call before
+     reading the file for the build:
+   ```c
+   Csv_Row_Index index = {0};
+   if (!csv_row_index_load(&index, "data.csv.idx", "data.csv", csv_default_config)) {
+       csv_row_index_stamp(&index, "data.csv");
+       csv_row_index_build(&index, file, csv_default_config, 0, 0);
+       csv_row_index_save(&index, "data.csv.idx", "data.csv");
+   }
+   Csv_String_View rows = {0};
+   csv_row_index_seek(&index, file, 50000000, 100, &rows); // Rows 50,000,000 to 50,000,099
+   csv_row_index_free(&index);
+   ```
+   Size and modification time are a heuristic, not a checksum: a rewrite that keeps the size and lands within the
+     filesystem's timestamp resolution (seconds on some, 2 s on FAT), or that puts the old time back (`touch -d`,
+     `cp -p`), goes unnoticed. Rebuild instead of loading when that can happen.
+
+   # Stats
+   To see what a particular file makes the parser do, compile with `CSV_STATS` defined (everywhere csv.h is included)
+     and read `csv_stats()` after or during the parse. It counts bytes, rows, items, quoted items, escape sequences and
+     the longest row, which costs a few additions per row and item. `CSV_STATS_TIMING` also times row splitting, item
+     splitting, unescaping and struct filling. Reading the clock on every call costs more than splitting a short item,
+     so compare the times with each other rather than with an uninstrumented build. Without either, none of it is
+     compiled in.
+   ```c
+   *csv_stats() = (Csv_Stats) {0};
+   while (csv_next_row(&file, &row, csv_default_config)) { ... }
+   Csv_Stats *stats = csv_stats();
+   printf("%llu rows, %llu quoted items, %llu escapes\n", stats->rows, stats->quoted_items, stats->escapes);
+   ```
+
+   # SIMD
+   Delimiter scanning uses SSE2, AVX2 or AVX-512. On x86-64 with GCC or Clang you don't need `-march=native` for that:
+     the row and item splitting, quote tracking, row counting and unescaping kernels are built for all three, and the
+     widest one the CPU supports is picked the first time they run, so one binary is fast on every machine.
+     `csv_simd_name()` tells you which one it was, and setting the `CSV_SIMD` environment variable to `sse2` or `avx2`
+     picks a narrower one. The rest of the library (the structural index, skipping rows and items, and the writer's
+     quoting) uses whatever the compiler targets, so `-march=native` (or `-mavx2`, etc) still helps there. Define `CSV_NO_DISPATCH` to only use what the compiler targets, or `CSV_NO_SIMD` to force the scalar code.
+   `./nob bench` builds and runs the benchmarks in the bench/ folder. Extra arguments are passed to the compiler:
+   ```console
+   $ ./nob bench -march=native
+   ```
+   bench_suite runs every parser path on every kind of data (narrow numbers, wide strings, lots of quotes, lots of
+     escapes, long lines) and also writes the GB/s, rows/s and cycles/byte to build/bench_suite.csv. To compare two
+     commits, run it on both with a results file and label of their own and diff or join the files:
+   ```console
+   $ ./build/bench_suite before.csv before
+   ```
+   For bigger or more realistic data, `./nob gen` builds bench/gen_dataset.c and runs it with the rest of the
+     arguments. It writes a CSV of any size that only depends on its options: the seed, column count, type mix,
+     string lengths, how often strings need quotes, escapes or contain newlines, and how many distinct values each
+     column has. See the top of bench/gen_dataset.c for all of them. The benchmarks make their data with the same
+     generator (bench/bench_common.h), so they all measure the same kind of bytes.
+   ```console
+   $ ./nob gen --seed=7 --size=4G --columns=32 --types=int:1,string:3 --quote-rate=0.2 build/big.csv
+   ```
+
 */
 #ifndef CSV_H_
 #define CSV_H_
@@ -131,46 +434,749 @@ typedef struct {
 typedef struct {
     char col_delim;
     char row_delim;
+    // Only special as the first character of an item. A quoted item must end with its closing quote right before a
+    // delimiter or the end of the row. Stray quotes elsewhere (`ab"c` or `"ab"c`) are not supported: the row splitting
+    // and counting functions take every unescaped quote as opening or closing one, so they may split such rows
+    // differently from csv_next_item().
     char quote;
-    char escape;
+    char escape; // Set it to `quote` for RFC 4180 files, where a quote inside a quoted item is written twice ("")
 } Csv_Config;
 
 bool csv_next_row(Csv_String_View *file, Csv_String_View *row, Csv_Config config);
 bool csv_next_item(Csv_String_View *row, Csv_String_View *item, Csv_Config config);
 
 extern Csv_Config csv_default_config;
+extern Csv_Config csv_rfc4180_config;
+
+// Parser functions specialized for one dialect, with the delimiters, quote and escape compiled in as constants
+// instead of loaded from a Csv_Config. They give the same results as the generic functions with that config.
+// Declare them anywhere with CSV_DECLARE_DIALECT, and define them once, after CSV_IMPLEMENTATION, with
+// CSV_DEFINE_DIALECT.
+#define CSV_DECLARE_DIALECT(prefix)                                                 \
+    bool prefix##_next_row(Csv_String_View *file, Csv_String_View *row);            \
+    bool prefix##_next_item(Csv_String_View *row, Csv_String_View *item);           \
+    bool prefix##_next_item_ex(Csv_String_View *row, Csv_Item *item)
+
+#define CSV_DEFINE_DIALECT(prefix, col_delim_, row_delim_, quote_, escape_)                 \
+    CSV__DIALECT_VARIANTS(prefix, CSV__DIALECT(col_delim_, row_delim_, quote_, escape_))    \
+    bool prefix##_next_row(Csv_String_View *file, Csv_String_View *row) {                   \
+        CSV__DIALECT_CALL(prefix##_next_row, (file, row))                                   \
+    }                                                                                       \
+    bool prefix##_next_item(Csv_String_View *row, Csv_String_View *item) {                  \
+        CSV__DIALECT_CALL(prefix##_next_item, (row, item))                                  \
+    }                                                                                       \
+    bool prefix##_next_item_ex(Csv_String_View *row, Csv_Item *item) {                      \
+        CSV__DIALECT_CALL(prefix##_next_item_ex, (row, item))                               \
+    }
+
+#define CSV__DIALECT(col_delim_, row_delim_, quote_, escape_) \
+    ((Csv_Config) { .col_delim = (col_delim_), .row_delim = (row_delim_), .quote = (quote_), .escape = (escape_) })
+
+// An item with what csv_next_item_ex() found out about it while scanning
+typedef struct {
+    Csv_String_View view; // Same as csv_next_item() gives you
+    bool quoted;
+    bool escaped;         // There are escape sequences in `view`, see csv_unescape()
+} Csv_Item;
+
+bool csv_next_item_ex(Csv_String_View *row, Csv_Item *item, Csv_Config config);
+
+// csv_default_config, csv_rfc4180_config, and csv_default_config with tabs and with pipes as column delimiters
+CSV_DECLARE_DIALECT(csv_comma);
+CSV_DECLARE_DIALECT(csv_rfc4180);
+CSV_DECLARE_DIALECT(csv_tsv);
+CSV_DECLARE_DIALECT(csv_psv);
+
+// The instruction set the row and item splitting runs on: "avx512", "avx2", "sse2" or "scalar". Unless csv.h was
+// compiled for AVX-512 (or with CSV_NO_DISPATCH), it's the best one the CPU running the program has.
+const char *csv_simd_name(void);
+
+// Drops the next `count` items of `row` without tokenizing them: column delimiters outside of quotes are counted
+// 64 bytes at a time. Skipping past the end leaves the row empty.
+void csv_skip_items(Csv_String_View *row, size_t count, Csv_Config config);
+
+// The columns to keep out of every row, in increasing order
+typedef struct {
+    const size_t *columns;
+    size_t count;
+} Csv_Projection;
+
+// Like csv_next_item(), but only gives you the items of the projected columns and skips the rest with csv_skip_items().
+// `cursor` is how many projected items were read from this row, set it to 0 before each row.
+bool csv_next_projected_item(Csv_String_View *row, const Csv_Projection *projection, size_t *cursor, Csv_String_View *item, Csv_Config config);
+
+typedef struct Csv__Arena_Block Csv__Arena_Block;
+
+// Bump allocator for unescaped items. Reset it once per batch of rows; memory is reused, never moved.
+typedef struct {
+    Csv__Arena_Block *first;
+    Csv__Arena_Block *current;
+} Csv_Arena;
+
+#ifndef CSV_ARENA_BLOCK_SIZE
+#define CSV_ARENA_BLOCK_SIZE (64*1024)
+#endif // CSV_ARENA_BLOCK_SIZE
+
+char *csv_arena_alloc(Csv_Arena *arena, size_t size);
+// Makes all the memory of the arena available again. Views returned by csv_unescape() become invalid.
+void csv_arena_reset(Csv_Arena *arena);
+void csv_arena_free(Csv_Arena *arena);
+
+// Returns the item with its escape sequences resolved. Items without escapes are returned as they are, without copying;
+// the others are written to `arena`.
+Csv_String_View csv_unescape(Csv_Arena *arena, Csv_Item item, Csv_Config config);
+
+// What the parser did on the calling thread, counted only when csv.h is compiled with CSV_STATS, and timed only with
+// CSV_STATS_TIMING. Rows are counted by csv_next_row() and items by csv_next_item() (and the _ex and dialect versions of
+// both), so everything built on them is counted too. Work done on other threads by the parallel APIs is added to the
+// caller's stats when they return.
+typedef struct {
+    uint64_t bytes;             // Bytes of rows split off, delimiters included
+    uint64_t rows;
+    uint64_t items;
+    uint64_t quoted_items;
+    uint64_t escapes;           // Escape sequences found in quoted items
+    uint64_t max_row_length;
+    uint64_t row_ns;            // Time spent in csv_next_row(), with CSV_STATS_TIMING
+    uint64_t item_ns;           // Time spent in csv_next_item(), with CSV_STATS_TIMING
+    uint64_t unescape_ns;       // Time spent in csv_unescape() copying escaped items
+    uint64_t fill_ns;           // Time spent in CSV_FILL_STRUCT and csv_schema_fill(), including their item splitting
+} Csv_Stats;
+
+// This thread's stats, which you can read or reset (`*csv_stats() = (Csv_Stats) {0}`) at any time.
+// Without CSV_STATS, they stay all zero.
+Csv_Stats *csv_stats(void);
+
+typedef struct {
+    size_t *items;
+    size_t count;
+    size_t capacity;
+} Csv_Offsets;
+
+// Structural index of a whole file, built once by csv_index_build() so rows and items can be looked up without rescanning
+typedef struct {
+    Csv_String_View file;
+    Csv_Offsets ends; // Offset of the delimiter that ends each item (or the end of the file)
+    Csv_Offsets rows; // Index into `ends` of the first item of each row, plus one past the last item
+} Csv_Index;
+
+bool csv_index_build(Csv_Index *index, Csv_String_View file, Csv_Config config);
+void csv_index_free(Csv_Index *index);
+size_t csv_index_row_count(const Csv_Index *index);
+size_t csv_index_item_count(const Csv_Index *index, size_t row);
+Csv_String_View csv_index_row(const Csv_Index *index, size_t row);
+Csv_String_View csv_index_item(const Csv_Index *index, size_t row, size_t item, Csv_Config config);
+
+// A run of whole rows of a file, as produced by csv_split_chunks()
+typedef struct {
+    Csv_String_View rows;
+    size_t index;         // Position of the chunk in the file, also the thread it runs on in csv_parallel_chunks()
+} Csv_Chunk;
+
+typedef void (*Csv_Chunk_Func)(Csv_Chunk chunk, void *user);
+
+// Splits `file` into `count` chunks of roughly equal size that start and end on row boundaries.
+// Row delimiters inside quoted fields are never used as split points. Some chunks may be empty.
+void csv_split_chunks(Csv_String_View file, Csv_Config config, Csv_Chunk *chunks, size_t count);
+// Splits `file` into one chunk per thread and calls `func` on every chunk at the same time.
+// Pass 0 threads to use one per CPU.
+void csv_parallel_chunks(Csv_String_View file, Csv_Config config, size_t threads, Csv_Chunk_Func func, void *user);
+
+// How csv_parallel_reduce() folds rows into a result. Every thread gets a `state_size`-byte state of its own, set up by
+// `init` (zeroed if it's NULL), and fed its rows one at a time through `row`, or all at once through `batch` if you'd
+// rather split them yourself. Set one of the two.
+typedef struct {
+    size_t state_size;
+    void (*init)(void *state, void *user);
+    void (*row)(void *state, Csv_String_View row, void *user);
+    void (*batch)(void *state, Csv_String_View rows, void *user);  // Whole rows, the thread's chunk of the file
+    // Folds `from` into `into`, and frees whatever `from` owns. The states are merged in file order. Required.
+    void (*merge)(void *into, void *from, void *user);
+} Csv_Reducer;
+
+// Splits `file` into one chunk of whole rows per thread (0 for one per CPU), reduces every chunk into its own state
+// on its own thread, and merges all of them into `result`, which is the state of the first chunk.
+void csv_parallel_reduce(Csv_String_View file, Csv_Config config, size_t threads, const Csv_Reducer *reducer, void *result, void *user);
+
+// Returns the number of rows csv_next_row() would give you, without making them: the row delimiters outside of quotes
+// are counted 64 bytes at a time with a popcount.
+size_t csv_count_rows(Csv_String_View file, Csv_Config config);
+// Same as csv_count_rows() on `threads` threads (0 for one per CPU), still in a single pass over the file
+size_t csv_count_rows_parallel(Csv_String_View file, Csv_Config config, size_t threads);
+
+// Where every `stride`th row of a file starts, to get to any row without parsing all the ones before it.
+// It can be saved next to the file as a sidecar, which is only loaded back if the file hasn't changed since.
+typedef struct {
+    uint64_t *offsets;     // offsets[i] is where row i*stride starts
+    size_t count;
+    uint64_t stride;
+    uint64_t rows;         // Rows in the whole file
+    uint64_t file_size;
+    int64_t file_mtime_ns; // Nanoseconds since the epoch, set by csv_row_index_stamp(), _save() and _load()
+    Csv_Config config;
+} Csv_Row_Index;
+
+#ifndef CSV_ROW_INDEX_STRIDE
+#define CSV_ROW_INDEX_STRIDE 1024
+#endif // CSV_ROW_INDEX_STRIDE
+
+// Records the modification time of `csv_path` for csv_row_index_save(). Call it before reading the file to build from,
+// so a write that lands during the build makes the save fail instead of stamping the index with the newer version.
+// Returns false and leaves errno set if the file can't be stat()ed.
+bool csv_row_index_stamp(Csv_Row_Index *index, const char *csv_path);
+// Scans `file` on `threads` threads (0 for one per CPU). A `stride` of 0 means CSV_ROW_INDEX_STRIDE.
+// Keeps the stamp from csv_row_index_stamp().
+void csv_row_index_build(Csv_Row_Index *index, Csv_String_View file, Csv_Config config, size_t stride, size_t threads);
+// Writes the offsets delta-encoded to `sidecar_path`, along with the size and modification time of `csv_path`.
+// Fails with EINVAL if `csv_path` is no longer what was stamped and built. Without a stamp the time is taken now,
+// which misses writes that happened during the build.
+// Returns false and leaves errno set on failure.
+bool csv_row_index_save(Csv_Row_Index *index, const char *sidecar_path, const char *csv_path);
+// Returns false if the sidecar can't be read, is corrupt, or was built for another version of `csv_path` or another config.
+// `index` is only changed on success.
+bool csv_row_index_load(Csv_Row_Index *index, const char *sidecar_path, const char *csv_path, Csv_Config config);
+// Sets `rows` to `count` rows of `file` starting at row `first`, fewer if the file ends before. Returns false if `first` is
+// past the end. Jumps straight to the closest indexed row, so at most `stride - 1` rows are parsed to find each end.
+bool csv_row_index_seek(const Csv_Row_Index *index, Csv_String_View file, uint64_t first, uint64_t count, Csv_String_View *rows);
+void csv_row_index_free(Csv_Row_Index *index);
+
+// Quote state carried from one block to the next, so scanning can stop and resume at any point
+typedef struct {
+    uint64_t in_quote; // all ones if the last block ended inside a quoted field
+    uint64_t escaped;  // 1 if the last block ended with an unfinished escape
+} Csv__Scan_State;
+
+// A file mapped into memory (or read into it, where mmap is not available), see csv_file_open()
+typedef struct {
+    Csv_String_View data; // The whole file
+    size_t advised;       // Readahead has been requested up to this offset
+    size_t released;      // Pages before this offset have been given back to the OS
+    bool mapped;
+} Csv_File;
+
+// How far ahead of the parser csv_file_advance() asks the OS to read, and how much it lets pile up before releasing it
+#ifndef CSV_FILE_WINDOW
+#define CSV_FILE_WINDOW (64*1024*1024)
+#endif // CSV_FILE_WINDOW
+
+// Maps the file at `path` read-only. Returns false and leaves errno set on failure.
+bool csv_file_open(Csv_File *file, const char *path);
+// Tells the file that everything before `consumed` (a pointer into `file->data`) has been parsed.
+// Prefetches the next window and releases the pages behind it, so RSS stays around two windows however big the file is.
+// Views into released pages stay valid, the OS just has to read them again.
+void csv_file_advance(Csv_File *file, const char *consumed);
+void csv_file_close(Csv_File *file);
+
+typedef void (*Csv_Row_Func)(Csv_String_View row, void *user);
+
+// Resumable parser for input that arrives in pieces (from read(), a socket, a pipe...).
+// Only the row that is still incomplete is buffered, so memory is bounded by the longest row, not the input.
+typedef struct {
+    char *items;            // Bytes of the incomplete row
+    size_t count;
+    size_t capacity;
+    Csv__Scan_State state;  // Quote state at the end of `items`
+} Csv_Stream;
+
+// Calls `on_row` for every row completed by `data`. Rows that fit in `data` are passed without copying.
+// Like all views, a row is only valid until `on_row` returns.
+void csv_stream_feed(Csv_Stream *stream, const char *data, size_t count, Csv_Config config, Csv_Row_Func on_row, void *user);
+// Call at the end of the input: passes the last row to `on_row` if it wasn't terminated by a row delimiter
+void csv_stream_finish(Csv_Stream *stream, Csv_Row_Func on_row, void *user);
+void csv_stream_free(Csv_Stream *stream);
 
 // Macros for internal use by the macro magic below
-#define CSV_SUPPORTED_TYPES 3
-static_assert(CSV_SUPPORTED_TYPES == 3, "Exhaustive handling of supported types in CSV__TYPE");
+typedef enum {
+    CSV_TYPE_INT,
+    CSV_TYPE_FLOAT,
+    CSV_TYPE_LONG,
+    CSV_TYPE_STRING_VIEW,
+    CSV_TYPE_COUNT,
+} Csv_Type;
+static_assert(CSV_TYPE_COUNT == 4, "Exhaustive handling of supported types in CSV__TYPE");
+
 #define CSV__TYPE(val) _Generic((val), \
-        int: "int",     \
-        float: "float",   \
-        long: "long",   \
-        Csv_String_View: "string_view"   \
+        int: CSV_TYPE_INT,     \
+        float: CSV_TYPE_FLOAT,   \
+        long: CSV_TYPE_LONG,   \
+        Csv_String_View: CSV_TYPE_STRING_VIEW   \
     )
 
 #define CSV__ARRAY_LEN(array) (sizeof(array)/sizeof(*array))
 
 typedef struct {
     size_t offset;
-    const char *type;
+    Csv_Type type;
+    const char *name;
 } Csv__Field;
 
 void csv__fill_struct(void *out, Csv_String_View *row, Csv_Config, const Csv__Field *fields, size_t fields_count);
 
 // CSVF is short for CSV_FIELD
-#define CSVF(field) { .offset = (size_t)&((typeof(_out))NULL)->field, .type = CSV__TYPE(_out->field) }
+#define CSVF(field) { .offset = (size_t)&((typeof(_out))NULL)->field, .type = CSV__TYPE(_out->field), .name = #field }
+// The field list is a constant, so it's built at compile time and not on every row
 #define CSV_FILL_STRUCT(row, config, out, ...) do { \
         typeof(out) *_out = &out;           \
-        Csv__Field fields[] = {__VA_ARGS__};    \
+        static const Csv__Field fields[] = {__VA_ARGS__};    \
         csv__fill_struct(_out, &(row), (config), fields, CSV__ARRAY_LEN(fields)); \
     } while(0)
 
+// The fields of a struct to fill from rows, see CSV_SCHEMA()
+typedef struct {
+    const Csv__Field *fields;
+    size_t count;
+} Csv_Schema;
+
+// Describes how to fill a `Type` from a row once, so it can be stored and passed around:
+// ```c
+// Csv_Schema schema = CSV_SCHEMA(User, CSVF(name), CSVF(id), CSVF(balance));
+// ```
+#define CSV_SCHEMA(Type, ...) ({                                                      \
+        Type *_out = NULL;                                                            \
+        (void)_out;                                                                   \
+        static const Csv__Field fields[] = {__VA_ARGS__};                             \
+        (Csv_Schema) { .fields = fields, .count = CSV__ARRAY_LEN(fields) };          \
+    })
+
+// Fills `out` from the items of `row`, same as CSV_FILL_STRUCT()
+void csv_schema_fill(const Csv_Schema *schema, Csv_String_View *row, Csv_Config config, void *out);
+
+// The column names of a header row, with a hash table to find a column by name
+typedef struct {
+    Csv_String_View *items;  // Column names. Copies, so the header outlives the buffer it was parsed from
+    size_t count;
+    size_t capacity;
+    uint32_t *slots;         // Open addressing, column + 1 or 0 if empty
+    size_t slots_count;      // Power of two
+    Csv_Arena arena;
+} Csv_Header;
+
+void csv_header_parse(Csv_Header *header, Csv_String_View row, Csv_Config config);
+// Returns false if no column is called `name`. With duplicate names, the first column wins.
+bool csv_header_find(const Csv_Header *header, Csv_String_View name, size_t *column);
+void csv_header_free(Csv_Header *header);
+
+// A Csv_Schema matched by name against a header: the fields sorted by the column they come from
+typedef struct {
+    Csv__Field *fields;
+    size_t *columns;
+    size_t count;
+} Csv_Binding;
+
+// Looks up the column of every field of `schema` (by the name of the struct field) in `header`.
+// Returns false if some fields have no column; those are bound to nothing and left alone by csv_binding_fill().
+bool csv_schema_bind(const Csv_Schema *schema, const Csv_Header *header, Csv_Binding *binding);
+// Fills `out` from the items of `row`, wherever the columns are. Costs the same as csv_schema_fill().
+void csv_binding_fill(const Csv_Binding *binding, Csv_String_View *row, Csv_Config config, void *out);
+void csv_binding_free(Csv_Binding *binding);
+
+typedef enum {
+    CSV_PREDICATE_EQ,        // The item is exactly `text`
+    CSV_PREDICATE_PREFIX,    // The item starts with `text`
+    CSV_PREDICATE_I64_RANGE, // The item is an integer in [i64.min, i64.max]
+    CSV_PREDICATE_F64_RANGE, // The item is a number in [f64.min, f64.max]
+} Csv_Predicate_Kind;
+
+// A condition on one item of a row, checked on the raw bytes before anything is converted.
+// The column is `column`, or the one called `name` in the header if `name` is set. An empty last column (the row ends
+// with the column delimiter) is the item "", so `CSV_PREDICATE_EQ` with "" matches it; a column the row doesn't have
+// at all never matches.
+typedef struct {
+    Csv_Predicate_Kind kind;
+    size_t column;
+    const char *name;
+    const char *text;
+    struct { int64_t min, max; } i64;
+    struct { double min, max; } f64;
+} Csv_Predicate;
+
+// Predicates that must all hold, sorted by column so a row is checked in one pass, see csv_filter_init()
+typedef struct {
+    Csv_Predicate *items;
+    size_t *text_counts;
+    size_t count;
+} Csv_Filter;
+
+// Resolves the column names of `predicates` against `header` (which can be NULL if none have a name).
+// Returns false if a column is not in the header; that predicate never matches.
+bool csv_filter_init(Csv_Filter *filter, const Csv_Predicate *predicates, size_t count, const Csv_Header *header);
+bool csv_filter_match(const Csv_Filter *filter, Csv_String_View row, Csv_Config config);
+// Same as csv_next_row(), but drops the rows that don't match `filter`
+bool csv_next_matching_row(Csv_String_View *file, Csv_String_View *row, const Csv_Filter *filter, Csv_Config config);
+void csv_filter_free(Csv_Filter *filter);
+
+typedef enum {
+    CSV_PARSE_OK,
+    CSV_PARSE_INVALID,  // Not a number, or something other than blanks after it
+    CSV_PARSE_OVERFLOW, // A number, but too big for the result type
+} Csv_Parse_Result;
+
+// Number parsers that read exactly the bytes of `sv` (no NUL terminator needed) and ignore the locale.
+// Floats are always correctly rounded. Only inf, nan and some numbers past 19 digits fall back to strtod() in the "C" locale.
+// Blanks (spaces and tabs) around the number are allowed. On error `*out` is left alone.
+Csv_Parse_Result csv_parse_i64(Csv_String_View sv, int64_t *out);
+Csv_Parse_Result csv_parse_f64(Csv_String_View sv, double *out);
+
+// Where a Csv_Writer sends its output, in blocks of about CSV_WRITER_BUFFER_SIZE bytes. Return false on error.
+typedef bool (*Csv_Sink_Func)(const char *data, size_t count, void *user);
+
+// A sink that writes to a FILE *, passed as `user`
+bool csv_sink_file(const char *data, size_t count, void *user);
+
+#ifndef CSV_WRITER_BUFFER_SIZE
+#define CSV_WRITER_BUFFER_SIZE (1024*1024)
+#endif // CSV_WRITER_BUFFER_SIZE
+
+// Buffered CSV output in the dialect of `config`, see csv_writer_init()
+typedef struct {
+    char *items;        // Output not passed to the sink yet
+    size_t count;
+    size_t capacity;
+    Csv_Config config;
+    Csv_Sink_Func sink;
+    void *user;
+    bool in_row;        // Something was written on the current row, so the next item needs a column delimiter
+    bool empty_last;    // The last item of the row was written as nothing, which reads back as no item if it ends the row
+    bool failed;        // The sink failed, everything after that is dropped
+} Csv_Writer;
+
+// With a NULL sink, the writer keeps all of its output in `items` instead of flushing it
+void csv_writer_init(Csv_Writer *writer, Csv_Config config, Csv_Sink_Func sink, void *user);
+// Items are quoted (and their quotes escaped) only if they contain a delimiter, a quote or an escape character.
+// An empty item is written as nothing, or as two quotes when it ends the row so that the row reads back the same.
+void csv_write_item(Csv_Writer *writer, Csv_String_View item);
+void csv_write_i64(Csv_Writer *writer, int64_t value);
+// Writes the shortest decimal that csv_parse_f64() reads back as exactly `value`, like 0.1 or 5e-324.
+// The decimal point is always '.', whatever the locale.
+void csv_write_f64(Csv_Writer *writer, double value);
+void csv_end_row(Csv_Writer *writer);
+// Writes `count` items and ends the row
+void csv_write_row(Csv_Writer *writer, const Csv_String_View *items, size_t count);
+// Passes everything buffered to the sink. Returns false if the sink failed, now or before.
+bool csv_writer_flush(Csv_Writer *writer);
+// Frees the buffer. Call csv_writer_flush() first, or whatever is left in the buffer is lost.
+void csv_writer_free(Csv_Writer *writer);
+
+// Formats rows [first, first + count) into `writer`, see csv_parallel_write()
+typedef void (*Csv_Format_Func)(Csv_Writer *writer, size_t first, size_t count, void *user);
+
+#ifndef CSV_WRITE_BATCH_ROWS
+#define CSV_WRITE_BATCH_ROWS 4096
+#endif // CSV_WRITE_BATCH_ROWS
+
+// Writes `rows` rows to `writer` on `threads` threads (0 means one per CPU). The rows are formatted in batches of
+// CSV_WRITE_BATCH_ROWS by `format`, into a writer of each thread's own, and the batches are passed on to `writer` in
+// order, so the output is exactly what formatting all the rows into `writer` on one thread would give.
+void csv_parallel_write(Csv_Writer *writer, size_t rows, size_t threads, Csv_Format_Func format, void *user);
+
+typedef enum {
+    CSV_COLUMN_I64,
+    CSV_COLUMN_F64,
+    CSV_COLUMN_STRING,      // Copied into the column's own bytes
+    CSV_COLUMN_STRING_VIEW, // Points into the parsed buffer, which must outlive the column
+} Csv_Column_Type;
+
+// A string in the 16-byte layout of Arrow's string_view: up to 12 bytes are stored inline,
+// longer strings keep a 4-byte prefix and the offset of the rest in a buffer
+typedef union {
+    struct {
+        int32_t length;
+        char data[12];
+    } inlined;
+    struct {
+        int32_t length;
+        char prefix[4];
+        int32_t buffer;
+        int32_t offset;
+    } ref;
+} Csv_View;
+
+// One column of a Csv_Batch. The layout is the same as Apache Arrow's, so the buffers can be handed over as they are.
+typedef struct {
+    Csv_Column_Type type;
+    size_t source;      // Which item of the row goes in this column
+    int64_t *i64;       // Values of a CSV_COLUMN_I64
+    double *f64;        // Values of a CSV_COLUMN_F64
+    int64_t *offsets;   // CSV_COLUMN_STRING: row i is bytes[offsets[i]..offsets[i + 1])
+    char *bytes;
+    size_t bytes_count;
+    size_t bytes_capacity;
+    Csv_View *views;    // CSV_COLUMN_STRING_VIEW: row i, with long strings at an offset from `base` (or `bytes` if unescaped)
+    const char *base;   // Where the rows of the current batch start in the parsed buffer
+    size_t base_count;
+    uint8_t *validity;  // Bit i (LSB first) is set if row i has a value. Missing items and numbers that don't parse are null.
+    size_t null_count;
+} Csv_Column;
+
+// Rows parsed straight into typed per-column buffers (struct-of-arrays), see csv_batch_read()
+typedef struct {
+    Csv_Column *columns;
+    size_t columns_count;
+    size_t rows;        // Rows in the current batch
+    size_t capacity;    // Most rows a batch can hold
+    int *by_source;     // Column of each item position, or -1 if the item isn't wanted
+    size_t sources;
+} Csv_Batch;
+
+// Sets up a batch with one column per entry of `types`, filled from the item at the same position in `sources`
+void csv_batch_init(Csv_Batch *batch, const Csv_Column_Type *types, const size_t *sources, size_t columns_count, size_t capacity);
+// Parses up to `batch->capacity` rows from `file` into the batch, replacing what was in it.
+// Returns the number of rows read, 0 once `file` is empty.
+size_t csv_batch_read(Csv_Batch *batch, Csv_String_View *file, Csv_Config config);
+void csv_batch_free(Csv_Batch *batch);
+
+// The Arrow C Data Interface, exactly as the spec says to copy it (https://arrow.apache.org/docs/format/CDataInterface.html)
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+  // Array type description
+  const char* format;
+  const char* name;
+  const char* metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema* dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowSchema*);
+  // Opaque producer-specific data
+  void* private_data;
+};
+
+struct ArrowArray {
+  // Array data description
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void** buffers;
+  struct ArrowArray** children;
+  struct ArrowArray* dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowArray*);
+  // Opaque producer-specific data
+  void* private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+// Exports the current batch as an Arrow struct array with one child per column, named after `names`.
+// The column buffers are moved into `array` without copying (the batch allocates new ones on the next read),
+// and CSV_COLUMN_STRING_VIEW children point into the parsed buffer (except for unescaped items), so it must outlive `array`.
+// Both `schema` and `array` must be released by the consumer as usual.
+void csv_batch_export_arrow(Csv_Batch *batch, const char *const *names, struct ArrowSchema *schema, struct ArrowArray *array);
+
 #endif // CSV_H_
 
 #ifdef CSV_IMPLEMENTATION
 
+// SIMD kernels are built for the instruction sets the target flags enable (e.g. -mavx2 or -march=native), and on
+// x86-64 with GCC or Clang also picked at runtime, see CSV__DISPATCH below.
+// Define CSV_NO_SIMD to force the portable scalar code.
+#if !defined(CSV_NO_SIMD) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64))
+#    include <immintrin.h>
+#    if defined(__AVX512BW__) && defined(__BMI2__)
+#        define CSV__AVX512
+#    endif
+#    if defined(__AVX2__)
+#        define CSV__AVX2
+#    endif
+#    if defined(__SSE2__) || defined(_M_X64)
+#        define CSV__SSE2
+#    endif
+#endif
+
+#if defined(CSV__AVX512)
+#    define CSV__ISA CSV__ISA_AVX512
+#elif defined(CSV__AVX2)
+#    define CSV__ISA CSV__ISA_AVX2
+#elif defined(CSV__SSE2)
+#    define CSV__ISA CSV__ISA_SSE2
+#else
+#    define CSV__ISA CSV__ISA_SCALAR
+#endif
+
+// On x86-64 with GCC or Clang, the row and item splitting, quote tracking, row counting and unescaping kernels are
+// also built for the wider instruction sets the compiler doesn't target, and the best ones the CPU has are picked on
+// first use, so one binary runs well everywhere. Define CSV_NO_DISPATCH to only use the kernels the compiler targets.
+// The rest stays on those: the loops that classify 64-byte blocks for the structural index, row and item skipping and
+// the writer's quoting, and the 16-byte compares of headers and filters, which SSE2 already covers.
+#if defined(CSV__SSE2) && !defined(CSV__AVX512) && defined(__x86_64__) && defined(__GNUC__) && !defined(CSV_NO_DISPATCH)
+#    define CSV__DISPATCH
+#    include <stdlib.h>
+#    define CSV__TARGET_AVX2   __attribute__((target("avx2,bmi,bmi2,popcnt,pclmul")))
+#    define CSV__TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx2,bmi,bmi2,popcnt,pclmul")))
+#    define CSV__TARGET_CLMUL  __attribute__((target("pclmul")))
+#else
+#    define CSV__TARGET_AVX2
+#    define CSV__TARGET_AVX512
+#    define CSV__TARGET_CLMUL
+#endif
+#if defined(CSV__AVX2) || defined(CSV__DISPATCH)
+#    define CSV__AVX2_KERNELS
+#endif
+#if defined(CSV__AVX512) || defined(CSV__DISPATCH)
+#    define CSV__AVX512_KERNELS
+#endif
+#if (defined(CSV__SSE2) && defined(__PCLMUL__)) || defined(CSV__DISPATCH)
+#    define CSV__CLMUL_KERNELS
+#endif
+
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+
+#ifndef CSV_REALLOC
+#include <stdlib.h>
+#define CSV_REALLOC realloc
+#endif // CSV_REALLOC
+
+#ifndef CSV_FREE
+#include <stdlib.h>
+#define CSV_FREE free
+#endif // CSV_FREE
+
+#define CSV__DA_INIT_CAP 256
+
+// Makes room for at least `n` more items in a dynamic array
+#define csv__da_reserve(da, n)                                                              \
+    do {                                                                                    \
+        if ((da)->count + (n) > (da)->capacity) {                                           \
+            if ((da)->capacity == 0) (da)->capacity = CSV__DA_INIT_CAP;                     \
+            while ((da)->count + (n) > (da)->capacity) (da)->capacity *= 2;                 \
+            (da)->items = CSV_REALLOC((da)->items, (da)->capacity*sizeof(*(da)->items));    \
+            assert((da)->items != NULL && "Buy more RAM lol");                              \
+        }                                                                                   \
+    } while (0)
+
+#define csv__da_append(da, item)                 \
+    do {                                         \
+        csv__da_reserve((da), 1);                \
+        (da)->items[(da)->count++] = (item);     \
+    } while (0)
+
+// Parallel APIs use pthreads where available. Define CSV_NO_THREADS to run them on the calling thread instead.
+#if !defined(CSV_NO_THREADS) && !defined(_WIN32)
+#    include <pthread.h>
+#    include <unistd.h>
+#    define CSV__THREADS
+#endif
+
+// Stats are kept per thread, so counting never touches memory shared with other threads
+#if defined(CSV_STATS_TIMING) && !defined(CSV_STATS)
+#    define CSV_STATS
+#endif
+#if defined(CSV_STATS)
+#    include <time.h>
+#    if defined(_MSC_VER) && !defined(__clang__)
+#        define CSV__THREAD_LOCAL __declspec(thread)
+#    else
+#        define CSV__THREAD_LOCAL _Thread_local
+#    endif
+static CSV__THREAD_LOCAL Csv_Stats csv__stats;
+#    define CSV__STAT(...) __VA_ARGS__
+#    if defined(CSV_STATS_TIMING)
+#        define CSV__STAT_TIME(...) __VA_ARGS__
+#    else
+#        define CSV__STAT_TIME(...)
+#    endif
+
+#    if defined(CSV_STATS_TIMING)
+static inline uint64_t csv__now_ns(void) {
+    struct timespec ts;
+#    if defined(CLOCK_MONOTONIC)
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#    else
+    timespec_get(&ts, TIME_UTC);
+#    endif
+    return (uint64_t)ts.tv_sec*1000000000 + (uint64_t)ts.tv_nsec;
+}
+#    endif // CSV_STATS_TIMING
+
+#    if defined(CSV__THREADS)
+static void csv__stats_add(Csv_Stats *to, const Csv_Stats *from) {
+    to->bytes        += from->bytes;
+    to->rows         += from->rows;
+    to->items        += from->items;
+    to->quoted_items += from->quoted_items;
+    to->escapes      += from->escapes;
+    to->row_ns       += from->row_ns;
+    to->item_ns      += from->item_ns;
+    to->unescape_ns  += from->unescape_ns;
+    to->fill_ns      += from->fill_ns;
+    if (from->max_row_length > to->max_row_length) to->max_row_length = from->max_row_length;
+}
+#    endif // CSV__THREADS
+
+Csv_Stats *csv_stats(void) {
+    return &csv__stats;
+}
+#else
+#    define CSV__STAT(...)
+#    define CSV__STAT_TIME(...)
+
+Csv_Stats *csv_stats(void) {
+    static Csv_Stats nothing_counted;
+    return &nothing_counted;
+}
+#endif // CSV_STATS
+
+// csv_file_open() maps files where mmap is available, and reads them into memory elsewhere
+#if !defined(_WIN32)
+#    include <errno.h>
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <unistd.h>
+#    define CSV__MMAP
+#endif
+// Sidecar row indexes are read and written with stdio, and checked against the file's stat()
+#include <stdio.h>
+#include <sys/stat.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+static inline unsigned csv__ctz32(uint32_t x) { unsigned long i; _BitScanForward(&i, x); return (unsigned)i; }
+static inline unsigned csv__ctz64(uint64_t x) { unsigned long i; _BitScanForward64(&i, x); return (unsigned)i; }
+static inline unsigned csv__clz64(uint64_t x) { unsigned long i; _BitScanReverse64(&i, x); return 63 - (unsigned)i; }
+#define csv__popcount64(x) ((unsigned)__popcnt64(x))
+// Low half of a*b, and the high half in `*high`
+static inline uint64_t csv__mul128(uint64_t a, uint64_t b, uint64_t *high) { return _umul128(a, b, high); }
+#else
+#define csv__ctz32(x) ((unsigned)__builtin_ctz(x))
+#define csv__ctz64(x) ((unsigned)__builtin_ctzll(x))
+#define csv__clz64(x) ((unsigned)__builtin_clzll(x))
+#define csv__popcount64(x) ((unsigned)__builtin_popcountll(x))
+static inline uint64_t csv__mul128(uint64_t a, uint64_t b, uint64_t *high) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128)a*b;
+    *high = (uint64_t)(product >> 64);
+    return (uint64_t)product;
+#else
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32, b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo*b_lo, hi_lo = a_hi*b_lo, lo_hi = a_lo*b_hi;
+    uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+    *high = a_hi*b_hi + (hi_lo >> 32) + (cross >> 32);
+    return (cross << 32) | (uint32_t)lo_lo;
+#endif
+}
+#endif
+
+// For the kernels the dialect functions are stamped from: they have to be inlined for the config to become constants
+#if defined(_MSC_VER) && !defined(__clang__)
+#define CSV__INLINE static __forceinline
+#else
+#define CSV__INLINE static inline __attribute__((always_inline))
+#endif
+
 Csv_Config csv_default_config = {
     .col_delim = ',',
     .row_delim = '\n',
@@ -178,93 +1184,3362 @@ Csv_Config csv_default_config = {
     .escape = '\\',
 };
 
-// Stolen from https://github.com/tsoding/nob.h
-Csv_String_View csv_sv_chop_by_delim(Csv_String_View *sv, char delim) {
-    size_t i = 0;
-    while (i < csv_sv_count(*sv) && sv->data[i] != delim) {
+Csv_Config csv_rfc4180_config = {
+    .col_delim = ',',
+    .row_delim = '\n',
+    .quote = '"',
+    .escape = '"',
+};
+
+// Instruction sets the scanning kernels come in. Each kernel has an `isa` parameter that is always a constant, so the
+// variants of the inlined primitives that are not used disappear. CSV__ISA_RUNTIME means the kernels picked for the CPU.
+#define CSV__ISA_RUNTIME -1
+#define CSV__ISA_SCALAR  0
+#define CSV__ISA_SSE2    1
+#define CSV__ISA_AVX2    2
+#define CSV__ISA_AVX512  3
+
+// Row delimiters of a piece of a file, for both quote states the piece could start in, so pieces can be counted
+// in parallel before anyone knows the quote state at their start
+typedef struct {
+    size_t rows[2];      // Row delimiters outside of quotes, if the piece starts outside [0] or inside [1] of quotes
+    bool ends_row[2];    // Whether the last byte is one of them
+    uint64_t in_quote;   // All ones if the piece flips the quote state
+} Csv__Row_Count;
+
+#if defined(CSV__DISPATCH)
+// The kernels of one instruction set, see csv__kernels()
+typedef struct {
+    int isa;
+    const char *name;
+    size_t (*find_byte)(const char *data, size_t count, char c);
+    size_t (*find_byte2)(const char *data, size_t count, char a, char b);
+    size_t (*find_row_end)(const char *data, size_t count, Csv_Config config, Csv__Scan_State *state);
+    void (*scan_quotes)(const char *data, size_t count, Csv_Config config, Csv__Scan_State *state);
+    Csv__Row_Count (*count_row_delims)(const char *data, size_t count, Csv_Config config);
+    size_t (*unescape_to)(char *out, const char *data, size_t count, Csv_Config config);
+} Csv__Kernels;
+
+static const Csv__Kernels *csv__kernels(void);
+#endif // CSV__DISPATCH
+
+// Each SIMD kernel compares a whole register of bytes at once and turns the result into a bitmask,
+// so finding the delimiter is just a count of trailing zeros. The scalar loop handles whatever is left.
+// The csv__scan_byte*() functions go on from `i` and return the index of the first match, or `count`.
+static inline size_t csv__scan_byte_scalar(const char *data, size_t count, char c, size_t i) {
+    while (i < count && data[i] != c) {
         i += 1;
     }
+    return i;
+}
 
-    Csv_String_View result = csv_sv_from_parts(csv_sv_data(*sv), i);
+#if defined(CSV__SSE2)
+static inline size_t csv__scan_byte_sse2(const char *data, size_t count, char c, size_t i) {
+    const __m128i needle128 = _mm_set1_epi8(c);
+    for (; i + 16 <= count; i += 16) {
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i)), needle128));
+        if (mask != 0) return i + csv__ctz32(mask);
+    }
+    return csv__scan_byte_scalar(data, count, c, i);
+}
+#endif // CSV__SSE2
 
-    if (i < csv_sv_count(*sv)) {
-        csv_sv_count(*sv) -= i + 1;
-        csv_sv_data(*sv)  += i + 1;
-    } else {
-        csv_sv_count(*sv) -= i;
-        csv_sv_data(*sv)  += i;
+#if defined(CSV__AVX2_KERNELS)
+CSV__TARGET_AVX2 static inline size_t csv__scan_byte_avx2(const char *data, size_t count, char c, size_t i) {
+    const __m256i needle256 = _mm256_set1_epi8(c);
+    for (; i + 32 <= count; i += 32) {
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i)), needle256));
+        if (mask != 0) return i + csv__ctz32(mask);
     }
+    return csv__scan_byte_sse2(data, count, c, i);
+}
+#endif // CSV__AVX2_KERNELS
 
-    return result;
+#if defined(CSV__AVX512_KERNELS)
+CSV__TARGET_AVX512 static inline size_t csv__scan_byte_avx512(const char *data, size_t count, char c, size_t i) {
+    const __m512i needle512 = _mm512_set1_epi8(c);
+    for (; i + 64 <= count; i += 64) {
+        uint64_t mask = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void *)(data + i)), needle512);
+        if (mask != 0) return i + csv__ctz64(mask);
+    }
+    if (i < count) {
+        __mmask64 load = _bzhi_u64(~0ULL, (unsigned)(count - i));
+        uint64_t mask = _mm512_mask_cmpeq_epi8_mask(load, _mm512_maskz_loadu_epi8(load, data + i), needle512);
+        return mask != 0 ? i + csv__ctz64(mask) : count;
+    }
+    return count;
 }
+#endif // CSV__AVX512_KERNELS
 
-bool csv_next_row(Csv_String_View *file, Csv_String_View *row, Csv_Config config) {
-    if (csv_sv_count(*file) == 0) return false;
+// Returns the index of the first `c` in `data`, or `count` if there is none
+CSV__INLINE size_t csv__find_byte_isa(const char *data, size_t count, char c, int isa) {
+#if defined(CSV__DISPATCH)
+    if (isa == CSV__ISA_RUNTIME) return csv__kernels()->find_byte(data, count, c);
+#endif // CSV__DISPATCH
+    if (isa == CSV__ISA_RUNTIME) isa = CSV__ISA;
+    size_t i = 0;
+#if defined(CSV__SSE2)
+    // Most fields and many rows are short, so probe the first 16 bytes before paying for the wide registers
+    if (isa >= CSV__ISA_SSE2 && count >= 16) {
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)data), _mm_set1_epi8(c)));
+        if (mask != 0) return csv__ctz32(mask);
+        i = 16;
+    }
+#endif // CSV__SSE2
+#if defined(CSV__AVX512_KERNELS)
+    if (isa == CSV__ISA_AVX512) return csv__scan_byte_avx512(data, count, c, i);
+#endif // CSV__AVX512_KERNELS
+#if defined(CSV__AVX2_KERNELS)
+    if (isa == CSV__ISA_AVX2) return csv__scan_byte_avx2(data, count, c, i);
+#endif // CSV__AVX2_KERNELS
+#if defined(CSV__SSE2)
+    if (isa == CSV__ISA_SSE2) return csv__scan_byte_sse2(data, count, c, i);
+#endif // CSV__SSE2
+    return csv__scan_byte_scalar(data, count, c, i);
+}
 
-    *row = csv_sv_chop_by_delim(file, config.row_delim);
-    return true;
+// Same as csv__scan_byte*(), but stop at either `a` or `b`
+static inline size_t csv__scan_byte2_scalar(const char *data, size_t count, char a, char b, size_t i) {
+    while (i < count && data[i] != a && data[i] != b) {
+        i += 1;
+    }
+    return i;
 }
 
-bool csv_next_item(Csv_String_View *row, Csv_String_View *item, Csv_Config config) {
-    if (csv_sv_count(*row) == 0) return false;
-    if (csv_sv_data(*row)[0] == config.quote) {
-        // Skip starting quote
-        csv_sv_data(*row)  += 1;
-        csv_sv_count(*row) -= 1;
+#if defined(CSV__SSE2)
+static inline size_t csv__scan_byte2_sse2(const char *data, size_t count, char a, char b, size_t i) {
+    const __m128i a128 = _mm_set1_epi8(a);
+    const __m128i b128 = _mm_set1_epi8(b);
+    for (; i + 16 <= count; i += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(data + i));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, a128), _mm_cmpeq_epi8(chunk, b128)));
+        if (mask != 0) return i + csv__ctz32(mask);
+    }
+    return csv__scan_byte2_scalar(data, count, a, b, i);
+}
+#endif // CSV__SSE2
 
-        csv_sv_data(*item) = csv_sv_data(*row);
+#if defined(CSV__AVX2_KERNELS)
+CSV__TARGET_AVX2 static inline size_t csv__scan_byte2_avx2(const char *data, size_t count, char a, char b, size_t i) {
+    const __m256i a256 = _mm256_set1_epi8(a);
+    const __m256i b256 = _mm256_set1_epi8(b);
+    for (; i + 32 <= count; i += 32) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i *)(data + i));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, a256), _mm256_cmpeq_epi8(chunk, b256)));
+        if (mask != 0) return i + csv__ctz32(mask);
+    }
+    return csv__scan_byte2_sse2(data, count, a, b, i);
+}
+#endif // CSV__AVX2_KERNELS
 
-        bool escape = false;
-        while (escape || *csv_sv_data(*row) != config.quote) {
-            if (!escape && *csv_sv_data(*row) == config.escape) {
-                escape = true;
-            } else {
-                escape = false;
-            }
+#if defined(CSV__AVX512_KERNELS)
+CSV__TARGET_AVX512 static inline size_t csv__scan_byte2_avx512(const char *data, size_t count, char a, char b, size_t i) {
+    const __m512i a512 = _mm512_set1_epi8(a);
+    const __m512i b512 = _mm512_set1_epi8(b);
+    for (; i < count; i += 64) {
+        __mmask64 load = count - i >= 64 ? ~0ULL : _bzhi_u64(~0ULL, (unsigned)(count - i));
+        __m512i chunk = _mm512_maskz_loadu_epi8(load, data + i);
+        uint64_t mask = (_mm512_cmpeq_epi8_mask(chunk, a512) | _mm512_cmpeq_epi8_mask(chunk, b512)) & load;
+        if (mask != 0) return i + csv__ctz64(mask);
+    }
+    return count;
+}
+#endif // CSV__AVX512_KERNELS
 
-            csv_sv_data(*row)  += 1;
-            csv_sv_count(*row) -= 1;
-        }
+CSV__INLINE size_t csv__find_byte2_isa(const char *data, size_t count, char a, char b, int isa) {
+#if defined(CSV__DISPATCH)
+    if (isa == CSV__ISA_RUNTIME) return csv__kernels()->find_byte2(data, count, a, b);
+#endif // CSV__DISPATCH
+    if (isa == CSV__ISA_RUNTIME) isa = CSV__ISA;
+#if defined(CSV__AVX512_KERNELS)
+    if (isa == CSV__ISA_AVX512) return csv__scan_byte2_avx512(data, count, a, b, 0);
+#endif // CSV__AVX512_KERNELS
+#if defined(CSV__AVX2_KERNELS)
+    if (isa == CSV__ISA_AVX2) return csv__scan_byte2_avx2(data, count, a, b, 0);
+#endif // CSV__AVX2_KERNELS
+#if defined(CSV__SSE2)
+    if (isa == CSV__ISA_SSE2) return csv__scan_byte2_sse2(data, count, a, b, 0);
+#endif // CSV__SSE2
+    return csv__scan_byte2_scalar(data, count, a, b, 0);
+}
 
-        csv_sv_count(*item) = csv_sv_data(*row) - csv_sv_data(*item);
+CSV__INLINE size_t csv__find_byte(const char *data, size_t count, char c) {
+    return csv__find_byte_isa(data, count, c, CSV__ISA_RUNTIME);
+}
 
-        // Skip ending quote
-        csv_sv_data(*row)  += 1;
-        csv_sv_count(*row) -= 1;
+CSV__INLINE size_t csv__find_byte2(const char *data, size_t count, char a, char b) {
+    return csv__find_byte2_isa(data, count, a, b, CSV__ISA_RUNTIME);
+}
 
-        if (*csv_sv_data(*row) == config.col_delim) {
-            csv_sv_data(*row)  += 1;
-            csv_sv_count(*row) -= 1;
-        }
-    } else {
-        *item = csv_sv_chop_by_delim(row, config.col_delim);
-    }
+// Bitmasks of the interesting bytes in a 64-byte block. Bit i corresponds to byte i of the block.
+typedef struct {
+    uint64_t quote;
+    uint64_t escape;
+    uint64_t row_delim;
+    uint64_t col_delim;
+} Csv__Block;
+
+static inline uint64_t csv__eq_mask64_scalar(const char *block, char c) {
+    uint64_t mask = 0;
+    for (int i = 0; i < 64; i++) {
+        mask |= (uint64_t)(block[i] == c) << i;
+    }
+    return mask;
+}
+
+#if defined(CSV__SSE2)
+static inline uint64_t csv__eq_mask64_sse2(const char *block, char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; i++) {
+        mask |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(block + 16*i)), needle)) << 16*i;
+    }
+    return mask;
+}
+#endif // CSV__SSE2
+
+#if defined(CSV__AVX2_KERNELS)
+CSV__TARGET_AVX2 static inline uint64_t csv__eq_mask64_avx2(const char *block, char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    uint64_t lo = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)block),        needle));
+    uint64_t hi = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(block + 32)), needle));
+    return lo | hi << 32;
+}
+#endif // CSV__AVX2_KERNELS
+
+#if defined(CSV__AVX512_KERNELS)
+CSV__TARGET_AVX512 static inline uint64_t csv__eq_mask64_avx512(const char *block, char c) {
+    return _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void *)block), _mm512_set1_epi8(c));
+}
+
+// Same as csv__classify_tail(), but masked-off bytes are not read at all, so there is no need to copy the tail out first
+CSV__TARGET_AVX512 static inline void csv__classify_tail_avx512(const char *data, size_t count, Csv_Config config, Csv__Block *masks) {
+    __mmask64 valid = count == 0 ? 0 : ~0ULL >> (64 - count);
+    __m512i block = _mm512_maskz_loadu_epi8(valid, data);
+    masks->quote     = _mm512_mask_cmpeq_epi8_mask(valid, block, _mm512_set1_epi8(config.quote));
+    masks->escape    = config.escape == config.quote ? 0 : _mm512_mask_cmpeq_epi8_mask(valid, block, _mm512_set1_epi8(config.escape));
+    masks->row_delim = _mm512_mask_cmpeq_epi8_mask(valid, block, _mm512_set1_epi8(config.row_delim));
+    masks->col_delim = _mm512_mask_cmpeq_epi8_mask(valid, block, _mm512_set1_epi8(config.col_delim));
+}
+#endif // CSV__AVX512_KERNELS
+
+CSV__INLINE uint64_t csv__eq_mask64(const char *block, char c, int isa) {
+#if defined(CSV__AVX512_KERNELS)
+    if (isa == CSV__ISA_AVX512) return csv__eq_mask64_avx512(block, c);
+#endif // CSV__AVX512_KERNELS
+#if defined(CSV__AVX2_KERNELS)
+    if (isa == CSV__ISA_AVX2) return csv__eq_mask64_avx2(block, c);
+#endif // CSV__AVX2_KERNELS
+#if defined(CSV__SSE2)
+    if (isa == CSV__ISA_SSE2) return csv__eq_mask64_sse2(block, c);
+#endif // CSV__SSE2
+    (void)isa;
+    return csv__eq_mask64_scalar(block, c);
+}
+
+CSV__INLINE void csv__classify_block_isa(const char *block, Csv_Config config, Csv__Block *masks, int isa) {
+    masks->quote     = csv__eq_mask64(block, config.quote, isa);
+    masks->escape    = config.escape == config.quote ? 0 : csv__eq_mask64(block, config.escape, isa);
+    masks->row_delim = csv__eq_mask64(block, config.row_delim, isa);
+    masks->col_delim = csv__eq_mask64(block, config.col_delim, isa);
+}
+
+// Same as csv__classify_block(), but for the last `count` (< 64) bytes of the input.
+// Bytes past the end never show up in any mask.
+CSV__INLINE void csv__classify_tail_isa(const char *data, size_t count, Csv_Config config, Csv__Block *masks, int isa) {
+#if defined(CSV__AVX512_KERNELS)
+    if (isa == CSV__ISA_AVX512) {
+        csv__classify_tail_avx512(data, count, config, masks);
+        return;
+    }
+#endif // CSV__AVX512_KERNELS
+    char block[64] = {0};
+    memcpy(block, data, count);
+    csv__classify_block_isa(block, config, masks, isa);
+    uint64_t valid = count == 0 ? 0 : ~0ULL >> (64 - count);
+    masks->quote     &= valid;
+    masks->escape    &= valid;
+    masks->row_delim &= valid;
+    masks->col_delim &= valid;
+}
+
+// The loops that are not dispatched at runtime use the kernels of the instruction set the compiler targets
+CSV__INLINE void csv__classify_block(const char *block, Csv_Config config, Csv__Block *masks) {
+    csv__classify_block_isa(block, config, masks, CSV__ISA);
+}
+
+CSV__INLINE void csv__classify_tail(const char *data, size_t count, Csv_Config config, Csv__Block *masks) {
+    csv__classify_tail_isa(data, count, config, masks, CSV__ISA);
+}
+
+#if defined(CSV__CLMUL_KERNELS)
+// Carry-less multiplication by all ones is exactly a prefix XOR
+CSV__TARGET_CLMUL static inline uint64_t csv__prefix_xor_clmul(uint64_t x) {
+    return (uint64_t)_mm_cvtsi128_si64(_mm_clmulepi64_si128(_mm_set_epi64x(0, (long long)x), _mm_set1_epi8((char)0xFF), 0));
+}
+#endif // CSV__CLMUL_KERNELS
+
+// Bit i of the result is the XOR of bits 0..i of `x`.
+// Applied to the quote mask it gives every byte that sits between an opening and a closing quote.
+CSV__INLINE uint64_t csv__prefix_xor(uint64_t x, int isa) {
+#if defined(__PCLMUL__) && defined(CSV__SSE2)
+    (void)isa;
+    return csv__prefix_xor_clmul(x);
+#else
+#if defined(CSV__CLMUL_KERNELS)
+    // Every CPU the AVX2 kernels are picked for has it
+    if (isa >= CSV__ISA_AVX2) return csv__prefix_xor_clmul(x);
+#endif // CSV__CLMUL_KERNELS
+    (void)isa;
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+#endif
+}
+
+// Returns the bytes that are preceded by an odd number of escape characters.
+// Same trick as simdjson: escape runs starting on even and odd bits are split apart with an addition,
+// so there is no loop over the bits.
+static inline uint64_t csv__escaped_mask(uint64_t escape, uint64_t *prev_escaped) {
+    if (escape == 0 && *prev_escaped == 0) return 0;
+    const uint64_t even_bits = 0x5555555555555555ULL;
+
+    escape &= ~*prev_escaped;
+    uint64_t follows_escape = escape << 1 | *prev_escaped;
+    uint64_t odd_sequence_starts = escape & ~even_bits & ~follows_escape;
+
+    uint64_t sequences_starting_on_even_bits = odd_sequence_starts + escape;
+    *prev_escaped = sequences_starting_on_even_bits < odd_sequence_starts;
+    uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+
+    return (even_bits ^ invert_mask) & follows_escape;
+}
+
+// Returns the mask of bytes inside quotes (opening quote included, closing quote excluded) and updates the state.
+// `count` is how many bytes of the block are real input, 64 except for the tail.
+CSV__INLINE uint64_t csv__quoted_mask_isa(const Csv__Block *masks, size_t count, Csv__Scan_State *state, int isa) {
+    uint64_t escaped = csv__escaped_mask(masks->escape, &state->escaped);
+    uint64_t quote = masks->quote & ~escaped;
+    // In a tail the carry out of bit 63 means nothing, but an escape in the last real byte does
+    if (count < 64) state->escaped = (masks->escape & ~escaped) >> (count - 1) & 1;
+    uint64_t inside = csv__prefix_xor(quote, isa) ^ state->in_quote;
+    state->in_quote = (uint64_t)((int64_t)inside >> 63);
+    return inside;
+}
+
+CSV__INLINE uint64_t csv__quoted_mask(const Csv__Block *masks, size_t count, Csv__Scan_State *state) {
+    return csv__quoted_mask_isa(masks, count, state, CSV__ISA);
+}
+
+// Returns the index of set bit number `n` (from 0) of `mask`, which must have more than `n` bits set
+static inline unsigned csv__select64(uint64_t mask, size_t n) {
+#if defined(CSV__SSE2) && defined(__BMI2__)
+    return csv__ctz64(_pdep_u64(1ULL << n, mask));
+#else
+    for (size_t i = 0; i < n; i++) mask &= mask - 1;
+    return csv__ctz64(mask);
+#endif
+}
+
+// Returns the offset of the first row delimiter outside of quotes, or `count` if there is none
+CSV__INLINE size_t csv__find_row_end_isa(const char *data, size_t count, Csv_Config config, Csv__Scan_State *state, int isa) {
+#if defined(CSV__DISPATCH)
+    if (isa == CSV__ISA_RUNTIME) return csv__kernels()->find_row_end(data, count, config, state);
+#endif // CSV__DISPATCH
+    if (isa == CSV__ISA_RUNTIME) isa = CSV__ISA;
+    Csv__Block masks;
+    size_t i = 0;
+    for (; i + 64 <= count; i += 64) {
+        csv__classify_block_isa(data + i, config, &masks, isa);
+        uint64_t row_delims = masks.row_delim & ~csv__quoted_mask_isa(&masks, 64, state, isa);
+        if (row_delims != 0) return i + csv__ctz64(row_delims);
+    }
+    if (i < count) {
+        csv__classify_tail_isa(data + i, count - i, config, &masks, isa);
+        uint64_t row_delims = masks.row_delim & ~csv__quoted_mask_isa(&masks, count - i, state, isa);
+        if (row_delims != 0) return i + csv__ctz64(row_delims);
+    }
+    return count;
+}
+
+// Runs the quote tracking over the whole input and leaves the state at its end
+CSV__INLINE void csv__scan_quotes_isa(const char *data, size_t count, Csv_Config config, Csv__Scan_State *state, int isa) {
+#if defined(CSV__DISPATCH)
+    if (isa == CSV__ISA_RUNTIME) {
+        csv__kernels()->scan_quotes(data, count, config, state);
+        return;
+    }
+#endif // CSV__DISPATCH
+    if (isa == CSV__ISA_RUNTIME) isa = CSV__ISA;
+    Csv__Block masks;
+    size_t i = 0;
+    for (; i + 64 <= count; i += 64) {
+        csv__classify_block_isa(data + i, config, &masks, isa);
+        csv__quoted_mask_isa(&masks, 64, state, isa);
+    }
+    if (i < count) {
+        csv__classify_tail_isa(data + i, count - i, config, &masks, isa);
+        csv__quoted_mask_isa(&masks, count - i, state, isa);
+    }
+}
+
+CSV__INLINE Csv__Row_Count csv__count_row_delims_isa(const char *data, size_t count, Csv_Config config, int isa) {
+#if defined(CSV__DISPATCH)
+    if (isa == CSV__ISA_RUNTIME) return csv__kernels()->count_row_delims(data, count, config);
+#endif // CSV__DISPATCH
+    if (isa == CSV__ISA_RUNTIME) isa = CSV__ISA;
+    Csv__Row_Count result = {0};
+    Csv__Scan_State state = {0};
+    Csv__Block masks;
+    for (size_t i = 0; i < count; i += 64) {
+        size_t n = count - i < 64 ? count - i : 64;
+        if (n == 64) csv__classify_block_isa(data + i, config, &masks, isa);
+        else         csv__classify_tail_isa(data + i, n, config, &masks, isa);
+        // Starting inside quotes flips every bit of the quoted mask, so one scan gives both counts
+        uint64_t inside = csv__quoted_mask_isa(&masks, n, &state, isa);
+        result.rows[0] += csv__popcount64(masks.row_delim & ~inside);
+        result.rows[1] += csv__popcount64(masks.row_delim & inside);
+        if (i + n == count) {
+            uint64_t last = 1ULL << (n - 1);
+            result.ends_row[0] = (masks.row_delim & ~inside & last) != 0;
+            result.ends_row[1] = (masks.row_delim & inside & last) != 0;
+        }
+    }
+    result.in_quote = state.in_quote;
+    return result;
+}
+
+// Copies the bytes of the 64-byte `block` whose bit is set in `keep` to `out`, in order, and returns how many there were
+static inline size_t csv__compress64(char *out, const char *block, uint64_t keep) {
+#if defined(CSV__AVX512) && defined(__AVX512VBMI2__)
+    _mm512_mask_compressstoreu_epi8(out, keep, _mm512_loadu_si512((const void *)block));
+    return csv__popcount64(keep);
+#else
+    if (keep == ~0ULL) {
+        memcpy(out, block, 64);
+        return 64;
+    }
+    // Runs of kept bytes, found with the bitmask instead of comparing bytes again
+    size_t written = 0;
+    while (keep != 0) {
+        unsigned start = csv__ctz64(keep);
+        unsigned length = csv__ctz64(~(keep >> start));
+        memcpy(out + written, block + start, length);
+        written += length;
+        if (start + length >= 64) break;
+        keep &= ~0ULL << (start + length);
+    }
+    return written;
+#endif
+}
+
+// Copies `data` to `out` without the escape characters, and returns how many bytes were written (at most `count`).
+// Works the same for `\"` and `""`: the escapes to drop are the ones not escaped themselves, found 64 bytes at a time
+// with the same odd-run trick as the quote tracking, and the rest of the block is compacted in one go.
+CSV__INLINE size_t csv__unescape_to_isa(char *out, const char *data, size_t count, Csv_Config config, int isa) {
+#if defined(CSV__DISPATCH)
+    if (isa == CSV__ISA_RUNTIME) return csv__kernels()->unescape_to(out, data, count, config);
+#endif // CSV__DISPATCH
+    if (isa == CSV__ISA_RUNTIME) isa = CSV__ISA;
+    size_t written = 0;
+    size_t i = 0;
+    uint64_t escaped = 0;
+    for (; i + 64 <= count; i += 64) {
+        uint64_t escape = csv__eq_mask64(data + i, config.escape, isa);
+        uint64_t drop = escape & ~csv__escaped_mask(escape, &escaped);
+        written += csv__compress64(out + written, data + i, ~drop);
+    }
+    // The tail goes through the same kernel from a padded copy, bytes past the end are never kept
+    if (i < count) {
+        char block[64] = {0};
+        memcpy(block, data + i, count - i);
+        uint64_t valid = ~0ULL >> (64 - (count - i));
+        uint64_t escape = csv__eq_mask64(block, config.escape, isa) & valid;
+        uint64_t drop = escape & ~csv__escaped_mask(escape, &escaped);
+        written += csv__compress64(out + written, block, ~drop & valid);
+    }
+    return written;
+}
+
+CSV__INLINE size_t csv__find_row_end(const char *data, size_t count, Csv_Config config, Csv__Scan_State *state) {
+    return csv__find_row_end_isa(data, count, config, state, CSV__ISA_RUNTIME);
+}
+
+CSV__INLINE void csv__scan_quotes(const char *data, size_t count, Csv_Config config, Csv__Scan_State *state) {
+    csv__scan_quotes_isa(data, count, config, state, CSV__ISA_RUNTIME);
+}
+
+CSV__INLINE Csv__Row_Count csv__count_row_delims(const char *data, size_t count, Csv_Config config) {
+    return csv__count_row_delims_isa(data, count, config, CSV__ISA_RUNTIME);
+}
+
+CSV__INLINE size_t csv__unescape_to(char *out, const char *data, size_t count, Csv_Config config) {
+    return csv__unescape_to_isa(out, data, count, config, CSV__ISA_RUNTIME);
+}
+
+#if defined(CSV__DISPATCH)
+// The kernels of every instruction set are the same code, inlined with a different constant `isa`
+#define CSV__DEFINE_KERNELS(suffix, isa, target)                                                                          \
+    target static size_t csv__find_byte_##suffix(const char *data, size_t count, char c) {                                \
+        return csv__find_byte_isa(data, count, c, isa);                                                                   \
+    }                                                                                                                     \
+    target static size_t csv__find_byte2_##suffix(const char *data, size_t count, char a, char b) {                       \
+        return csv__find_byte2_isa(data, count, a, b, isa);                                                               \
+    }                                                                                                                     \
+    target static size_t csv__find_row_end_##suffix(const char *data, size_t count, Csv_Config config, Csv__Scan_State *state) { \
+        return csv__find_row_end_isa(data, count, config, state, isa);                                                    \
+    }                                                                                                                     \
+    target static void csv__scan_quotes_##suffix(const char *data, size_t count, Csv_Config config, Csv__Scan_State *state) { \
+        csv__scan_quotes_isa(data, count, config, state, isa);                                                            \
+    }                                                                                                                     \
+    target static Csv__Row_Count csv__count_row_delims_##suffix(const char *data, size_t count, Csv_Config config) {      \
+        return csv__count_row_delims_isa(data, count, config, isa);                                                       \
+    }                                                                                                                     \
+    target static size_t csv__unescape_to_##suffix(char *out, const char *data, size_t count, Csv_Config config) {        \
+        return csv__unescape_to_isa(out, data, count, config, isa);                                                       \
+    }                                                                                                                     \
+    static const Csv__Kernels csv__kernels_##suffix = {                                                                   \
+        isa, #suffix, csv__find_byte_##suffix, csv__find_byte2_##suffix, csv__find_row_end_##suffix,                     \
+        csv__scan_quotes_##suffix, csv__count_row_delims_##suffix, csv__unescape_to_##suffix,                             \
+    };
+
+CSV__DEFINE_KERNELS(sse2,   CSV__ISA_SSE2,   )
+CSV__DEFINE_KERNELS(avx2,   CSV__ISA_AVX2,   CSV__TARGET_AVX2)
+CSV__DEFINE_KERNELS(avx512, CSV__ISA_AVX512, CSV__TARGET_AVX512)
+
+static const Csv__Kernels *csv__selected_kernels = NULL;
+
+// Picks the widest kernels the CPU (and the OS, for the wider registers) supports. The CSV_SIMD environment variable
+// can ask for narrower ones, e.g. CSV_SIMD=sse2 to compare them on the same machine.
+static const Csv__Kernels *csv__select_kernels(void) {
+    __builtin_cpu_init();
+    const Csv__Kernels *kernels = &csv__kernels_sse2;
+    bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2")
+             && __builtin_cpu_supports("popcnt") && __builtin_cpu_supports("pclmul");
+    if (avx2) kernels = &csv__kernels_avx2;
+    if (avx2 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) kernels = &csv__kernels_avx512;
+
+    const char *wanted = getenv("CSV_SIMD");
+    if (wanted != NULL) {
+        const Csv__Kernels *all[] = { &csv__kernels_sse2, &csv__kernels_avx2, &csv__kernels_avx512 };
+        for (size_t i = 0; i < CSV__ARRAY_LEN(all); i++) {
+            if (strcmp(wanted, all[i]->name) == 0 && all[i]->isa <= kernels->isa) kernels = all[i];
+        }
+    }
+    return kernels;
+}
+
+static const Csv__Kernels *csv__kernels(void) {
+    // Every thread that gets here first picks the same kernels, so the race is harmless
+    const Csv__Kernels *kernels = __atomic_load_n(&csv__selected_kernels, __ATOMIC_ACQUIRE);
+    if (kernels == NULL) {
+        kernels = csv__select_kernels();
+        __atomic_store_n(&csv__selected_kernels, kernels, __ATOMIC_RELEASE);
+    }
+    return kernels;
+}
+#endif // CSV__DISPATCH
+
+const char *csv_simd_name(void) {
+#if defined(CSV__DISPATCH)
+    return csv__kernels()->name;
+#else
+    switch (CSV__ISA) {
+    case CSV__ISA_AVX512: return "avx512";
+    case CSV__ISA_AVX2:   return "avx2";
+    case CSV__ISA_SSE2:   return "sse2";
+    default:              return "scalar";
+    }
+#endif // CSV__DISPATCH
+}
+
+// Splits `sv` at index `i`, dropping the delimiter at `i` if there is one
+static inline Csv_String_View csv__sv_chop_at(Csv_String_View *sv, size_t i) {
+    Csv_String_View result = csv_sv_from_parts(csv_sv_data(*sv), i);
+
+    if (i < csv_sv_count(*sv)) {
+        csv_sv_count(*sv) -= i + 1;
+        csv_sv_data(*sv)  += i + 1;
+    } else {
+        csv_sv_count(*sv) -= i;
+        csv_sv_data(*sv)  += i;
+    }
+
+    return result;
+}
+
+// Stolen from https://github.com/tsoding/nob.h
+Csv_String_View csv_sv_chop_by_delim(Csv_String_View *sv, char delim) {
+    return csv__sv_chop_at(sv, csv__find_byte(csv_sv_data(*sv), csv_sv_count(*sv), delim));
+}
+
+CSV__INLINE bool csv__next_row(Csv_String_View *file, Csv_String_View *row, Csv_Config config, int isa) {
+    if (csv_sv_count(*file) == 0) return false;
+
+    CSV__STAT(size_t before = csv_sv_count(*file));
+    CSV__STAT_TIME(uint64_t start = csv__now_ns());
+
+    // Row delimiters inside quoted fields are part of the field, not the end of the row
+    Csv__Scan_State state = {0};
+    *row = csv__sv_chop_at(file, csv__find_row_end_isa(csv_sv_data(*file), csv_sv_count(*file), config, &state, isa));
+
+    CSV__STAT(
+        csv__stats.bytes += before - csv_sv_count(*file);
+        csv__stats.rows += 1;
+        if (csv_sv_count(*row) > csv__stats.max_row_length) csv__stats.max_row_length = csv_sv_count(*row);
+    )
+    CSV__STAT_TIME(csv__stats.row_ns += csv__now_ns() - start);
+    return true;
+}
+
+bool csv_next_row(Csv_String_View *file, Csv_String_View *row, Csv_Config config) {
+    return csv__next_row(file, row, config, CSV__ISA_RUNTIME);
+}
+
+// Appends the position of every set bit of `mask` (offset by `base`) to `offsets`
+static inline void csv__push_bits(Csv_Offsets *offsets, uint64_t mask, size_t base) {
+    // Reserve for the whole block up front so the bit loop has no capacity checks
+    csv__da_reserve(offsets, 64);
+    size_t *out = offsets->items + offsets->count;
+    while (mask != 0) {
+        *out++ = base + csv__ctz64(mask);
+        mask &= mask - 1;
+    }
+    offsets->count = out - offsets->items;
+}
+
+// Offset of the first byte of the item that ends at `index->ends.items[end_index]`
+static inline size_t csv__index_start(const Csv_Index *index, size_t end_index) {
+    return end_index == 0 ? 0 : index->ends.items[end_index - 1] + 1;
+}
+
+bool csv_index_build(Csv_Index *index, Csv_String_View file, Csv_Config config) {
+    const char *data = csv_sv_data(file);
+    size_t count = csv_sv_count(file);
+
+    index->file = file;
+    index->ends.count = 0;
+    index->rows.count = 0;
+    csv__da_append(&index->rows, 0);
+
+    // Stage 1: every byte is classified exactly once, and only the structural delimiters are kept
+    Csv__Scan_State state = {0};
+    Csv__Block masks;
+    for (size_t i = 0; i < count; i += 64) {
+        if (i + 64 <= count) {
+            csv__classify_block(data + i, config, &masks);
+        } else {
+            csv__classify_tail(data + i, count - i, config, &masks);
+        }
+        uint64_t outside = ~csv__quoted_mask(&masks, i + 64 <= count ? 64 : count - i, &state);
+        uint64_t row_delims = masks.row_delim & outside;
+        uint64_t col_delims = masks.col_delim & outside;
+
+        if (row_delims == 0) {
+            csv__push_bits(&index->ends, col_delims, i);
+            continue;
+        }
+        // Split the block at each row delimiter so we know which item ends each row
+        while (row_delims != 0) {
+            uint64_t upto = row_delims ^ (row_delims - 1); // bits up to and including the lowest row delimiter
+            csv__push_bits(&index->ends, (col_delims | row_delims) & upto, i);
+            csv__da_append(&index->rows, index->ends.count);
+            col_delims &= ~upto;
+            row_delims &= ~upto;
+        }
+        csv__push_bits(&index->ends, col_delims, i);
+    }
+
+    // Like csv_next_row(), a file that doesn't end with a row delimiter still has a last row
+    size_t last_row = index->rows.items[index->rows.count - 1];
+    if (index->ends.count > last_row || csv__index_start(index, last_row) < count) {
+        csv__da_append(&index->ends, count);
+        csv__da_append(&index->rows, index->ends.count);
+    }
+
+    return true;
+}
+
+void csv_index_free(Csv_Index *index) {
+    CSV_FREE(index->ends.items);
+    CSV_FREE(index->rows.items);
+    memset(index, 0, sizeof(*index));
+}
+
+size_t csv_index_row_count(const Csv_Index *index) {
+    return index->rows.count == 0 ? 0 : index->rows.count - 1;
+}
+
+Csv_String_View csv_index_row(const Csv_Index *index, size_t row) {
+    assert(row < csv_index_row_count(index));
+    size_t start = csv__index_start(index, index->rows.items[row]);
+    size_t end = index->ends.items[index->rows.items[row + 1] - 1];
+    return csv_sv_from_parts(csv_sv_data(index->file) + start, end - start);
+}
+
+size_t csv_index_item_count(const Csv_Index *index, size_t row) {
+    assert(row < csv_index_row_count(index));
+    size_t first = index->rows.items[row];
+    size_t last = index->rows.items[row + 1] - 1;
+    size_t start = csv__index_start(index, first);
+    size_t end = index->ends.items[last];
+    // Same as csv_next_item(): an empty row has no items and a trailing column delimiter doesn't start a new one
+    if (start == end) return 0;
+    if (last > first && index->ends.items[last - 1] + 1 == end) return last - first;
+    return last - first + 1;
+}
+
+Csv_String_View csv_index_item(const Csv_Index *index, size_t row, size_t item, Csv_Config config) {
+    assert(item < csv_index_item_count(index, row));
+    size_t end_index = index->rows.items[row] + item;
+    size_t start = csv__index_start(index, end_index);
+    size_t end = index->ends.items[end_index];
+
+    const char *data = csv_sv_data(index->file);
+    if (start < end && data[start] == config.quote) {
+        start += 1;
+        if (end > start && data[end - 1] == config.quote) end -= 1;
+    }
+    return csv_sv_from_parts((char *)data + start, end - start);
+}
+
+#if defined(CSV__MMAP)
+static size_t csv__page_size(void) {
+    long size = sysconf(_SC_PAGESIZE);
+    return size > 0 ? (size_t)size : 4096;
+}
+#endif // CSV__MMAP
+
+bool csv_file_open(Csv_File *file, const char *path) {
+    memset(file, 0, sizeof(*file));
+#if defined(CSV__MMAP)
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return false;
+    }
+
+    size_t size = (size_t)st.st_size;
+    if (size == 0) {
+        close(fd);
+        return true;
+    }
+
+    void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    int saved = errno;
+    // The mapping keeps the file alive on its own
+    close(fd);
+    if (data == MAP_FAILED) {
+        errno = saved;
+        return false;
+    }
+
+    file->data = csv_sv_from_parts((char *)data, size);
+    file->mapped = true;
+
+    // These are only hints, so failures don't matter
+    madvise(data, size, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    madvise(data, size, MADV_HUGEPAGE);
+#endif // MADV_HUGEPAGE
+    csv_file_advance(file, data);
+    return true;
+#else
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return false;
+
+    char *data = NULL;
+    size_t size = 0;
+    if (fseek(f, 0, SEEK_END) < 0) goto fail;
+    long m = ftell(f);
+    if (m < 0) goto fail;
+    if (fseek(f, 0, SEEK_SET) < 0) goto fail;
+
+    size = (size_t)m;
+    data = CSV_REALLOC(NULL, size > 0 ? size : 1);
+    assert(data != NULL && "Buy more RAM lol");
+    if (fread(data, 1, size, f) != size) goto fail;
+
+    fclose(f);
+    file->data = csv_sv_from_parts(data, size);
+    return true;
+
+fail:
+    CSV_FREE(data);
+    fclose(f);
+    return false;
+#endif // CSV__MMAP
+}
+
+void csv_file_advance(Csv_File *file, const char *consumed) {
+#if defined(CSV__MMAP)
+    if (!file->mapped) return;
+
+    char *base = (char *)csv_sv_data(file->data);
+    size_t size = csv_sv_count(file->data);
+    size_t pos = (size_t)(consumed - base);
+    size_t page = csv__page_size();
+
+    // Ask for the next window before the parser gets there, one window at a time
+    if (file->advised < size && pos + CSV_FILE_WINDOW > file->advised) {
+        size_t start = file->advised/page*page;
+        size_t end = pos + 2*CSV_FILE_WINDOW < size ? pos + 2*CSV_FILE_WINDOW : size;
+        madvise(base + start, end - start, MADV_WILLNEED);
+        file->advised = end;
+    }
+
+    // Give back what's been parsed, but only in big steps to keep the syscalls rare
+    size_t release = pos/page*page;
+    if (release >= file->released + CSV_FILE_WINDOW) {
+        madvise(base + file->released, release - file->released, MADV_DONTNEED);
+        file->released = release;
+    }
+#else
+    (void)file;
+    (void)consumed;
+#endif // CSV__MMAP
+}
+
+void csv_file_close(Csv_File *file) {
+#if defined(CSV__MMAP)
+    if (file->mapped) munmap((void *)csv_sv_data(file->data), csv_sv_count(file->data));
+#else
+    CSV_FREE((void *)csv_sv_data(file->data));
+#endif // CSV__MMAP
+    memset(file, 0, sizeof(*file));
+}
+
+void csv_stream_feed(Csv_Stream *stream, const char *data, size_t count, Csv_Config config, Csv_Row_Func on_row, void *user) {
+    while (count > 0) {
+        // Continue the incomplete row from the previous piece where its scan stopped
+        Csv__Scan_State state = stream->count > 0 ? stream->state : (Csv__Scan_State) {0};
+        size_t end = csv__find_row_end(data, count, config, &state);
+        if (end == count) {
+            csv__da_reserve(stream, count);
+            memcpy(stream->items + stream->count, data, count);
+            stream->count += count;
+            stream->state = state;
+            return;
+        }
+
+        if (stream->count > 0) {
+            csv__da_reserve(stream, end);
+            memcpy(stream->items + stream->count, data, end);
+            on_row(csv_sv_from_parts(stream->items, stream->count + end), user);
+            stream->count = 0;
+        } else {
+            on_row(csv_sv_from_parts((char *)data, end), user);
+        }
+        data  += end + 1;
+        count -= end + 1;
+    }
+}
+
+void csv_stream_finish(Csv_Stream *stream, Csv_Row_Func on_row, void *user) {
+    if (stream->count > 0) on_row(csv_sv_from_parts(stream->items, stream->count), user);
+    stream->count = 0;
+}
+
+void csv_stream_free(Csv_Stream *stream) {
+    CSV_FREE(stream->items);
+    memset(stream, 0, sizeof(*stream));
+}
+
+static size_t csv__cpu_count(void) {
+#if defined(CSV__THREADS)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (size_t)n : 1;
+#else
+    return 1;
+#endif
+}
+
+typedef void (*Csv__Task_Func)(size_t task, void *arg);
+
+#if defined(CSV__THREADS)
+typedef struct {
+    Csv__Task_Func func;
+    void *arg;
+    size_t task;
+    CSV__STAT(Csv_Stats stats;) // What the task counted, added to the stats of the thread that started it
+} Csv__Thread;
+
+static void *csv__thread_main(void *arg) {
+    Csv__Thread *thread = arg;
+    thread->func(thread->task, thread->arg);
+    CSV__STAT(thread->stats = csv__stats);
+    return NULL;
+}
+#endif // CSV__THREADS
+
+// Calls `func(i, arg)` for every i in [0, count), each on its own thread. The calling thread runs task 0,
+// and also the tasks of any threads that could not be started.
+static void csv__run_tasks(size_t count, Csv__Task_Func func, void *arg) {
+#if defined(CSV__THREADS)
+    if (count <= 1) {
+        if (count == 1) func(0, arg);
+        return;
+    }
+
+    Csv__Thread *threads = CSV_REALLOC(NULL, count*sizeof(*threads));
+    pthread_t *handles = CSV_REALLOC(NULL, count*sizeof(*handles));
+    assert(threads != NULL && handles != NULL && "Buy more RAM lol");
+
+    size_t started = 1;
+    for (; started < count; started++) {
+        threads[started] = (Csv__Thread) { .func = func, .arg = arg, .task = started };
+        if (pthread_create(&handles[started], NULL, csv__thread_main, &threads[started]) != 0) break;
+    }
+    for (size_t i = started; i < count; i++) func(i, arg);
+    func(0, arg);
+    for (size_t i = 1; i < started; i++) {
+        pthread_join(handles[i], NULL);
+        CSV__STAT(csv__stats_add(&csv__stats, &threads[i].stats));
+    }
+
+    CSV_FREE(threads);
+    CSV_FREE(handles);
+#else
+    for (size_t i = 0; i < count; i++) func(i, arg);
+#endif // CSV__THREADS
+}
+
+// Evenly spaced places to cut `data` into `count` pieces, in `starts[0..count]`.
+// A guess right after an escape character could split an escape sequence, so move past those.
+static void csv__split_guesses(const char *data, size_t size, Csv_Config config, size_t *starts, size_t count) {
+    for (size_t i = 0; i <= count; i++) {
+        size_t start = size/count*i;
+        if (i == count) start = size;
+        if (config.escape != config.quote) {
+            while (start > 0 && start < size && data[start - 1] == config.escape) start += 1;
+        }
+        starts[i] = i > 0 && start < starts[i - 1] ? starts[i - 1] : start;
+    }
+}
+
+typedef struct {
+    const char *data;
+    Csv_Config config;
+    size_t *starts;
+    uint64_t *in_quote;
+} Csv__Parity_Pass;
+
+static void csv__parity_task(size_t task, void *arg) {
+    Csv__Parity_Pass *pass = arg;
+    Csv__Scan_State state = {0};
+    csv__scan_quotes(pass->data + pass->starts[task], pass->starts[task + 1] - pass->starts[task], pass->config, &state);
+    pass->in_quote[task] = state.in_quote;
+}
+
+static void csv__split_chunks(Csv_String_View file, Csv_Config config, Csv_Chunk *chunks, size_t count, bool parallel) {
+    const char *data = csv_sv_data(file);
+    size_t size = csv_sv_count(file);
+
+    size_t *starts = CSV_REALLOC(NULL, (count + 1)*sizeof(*starts));
+    uint64_t *in_quote = CSV_REALLOC(NULL, count*sizeof(*in_quote));
+    assert(starts != NULL && in_quote != NULL && "Buy more RAM lol");
+
+    csv__split_guesses(data, size, config, starts, count);
+
+    // Pass 1: whether each piece flips the quote state, computed in parallel
+    Csv__Parity_Pass pass = { .data = data, .config = config, .starts = starts, .in_quote = in_quote };
+    if (parallel) {
+        csv__run_tasks(count, csv__parity_task, &pass);
+    } else {
+        for (size_t i = 0; i < count; i++) csv__parity_task(i, &pass);
+    }
+
+    // Pass 2: a prefix XOR of those flips is the quote state at each guess,
+    // and from there the chunk starts right after the next row delimiter outside of quotes
+    uint64_t quoted = 0;
+    size_t prev_end = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t end = size;
+        quoted ^= in_quote[i];
+        if (i + 1 < count && starts[i + 1] < size) {
+            size_t guess = starts[i + 1] < prev_end ? prev_end : starts[i + 1];
+            Csv__Scan_State state = { .in_quote = guess == starts[i + 1] ? quoted : 0 };
+            end = guess + csv__find_row_end(data + guess, size - guess, config, &state);
+            if (end < size) end += 1;
+        }
+        chunks[i].index = i;
+        chunks[i].rows = csv_sv_from_parts((char *)data + prev_end, end - prev_end);
+        prev_end = end;
+    }
+
+    CSV_FREE(starts);
+    CSV_FREE(in_quote);
+}
+
+void csv_split_chunks(Csv_String_View file, Csv_Config config, Csv_Chunk *chunks, size_t count) {
+    if (count == 0) return;
+    csv__split_chunks(file, config, chunks, count, false);
+}
+
+typedef struct {
+    Csv_Chunk *chunks;
+    Csv_Chunk_Func func;
+    void *user;
+} Csv__Chunks_Pass;
+
+static void csv__chunk_task(size_t task, void *arg) {
+    Csv__Chunks_Pass *pass = arg;
+    pass->func(pass->chunks[task], pass->user);
+}
+
+void csv_parallel_chunks(Csv_String_View file, Csv_Config config, size_t threads, Csv_Chunk_Func func, void *user) {
+    if (threads == 0) threads = csv__cpu_count();
+
+    Csv_Chunk *chunks = CSV_REALLOC(NULL, threads*sizeof(*chunks));
+    assert(chunks != NULL && "Buy more RAM lol");
+    csv__split_chunks(file, config, chunks, threads, true);
+
+    Csv__Chunks_Pass pass = { .chunks = chunks, .func = func, .user = user };
+    csv__run_tasks(threads, csv__chunk_task, &pass);
+
+    CSV_FREE(chunks);
+}
+
+typedef struct {
+    Csv_Chunk *chunks;
+    void **states;
+    const Csv_Reducer *reducer;
+    Csv_Config config;
+    void *user;
+} Csv__Reduce_Pass;
+
+static void csv__reduce_task(size_t task, void *arg) {
+    Csv__Reduce_Pass *pass = arg;
+    const Csv_Reducer *reducer = pass->reducer;
+    void *state = pass->states[task];
+    // Set up on the thread that uses it, so its pages are local to that thread
+    if (reducer->init != NULL) reducer->init(state, pass->user);
+    else memset(state, 0, reducer->state_size);
+
+    Csv_String_View rows = pass->chunks[task].rows;
+    if (reducer->batch != NULL) {
+        if (csv_sv_count(rows) > 0) reducer->batch(state, rows, pass->user);
+        return;
+    }
+    Csv_String_View row = {0};
+    while (csv__next_row(&rows, &row, pass->config, CSV__ISA_RUNTIME)) reducer->row(state, row, pass->user);
+}
+
+void csv_parallel_reduce(Csv_String_View file, Csv_Config config, size_t threads, const Csv_Reducer *reducer, void *result, void *user) {
+    assert((reducer->row != NULL) != (reducer->batch != NULL) && "Set either `row` or `batch`");
+    // Checked up front, so a missing `merge` fails on one core too instead of only where there are states to merge
+    assert(reducer->merge != NULL && "Set `merge`");
+    if (threads == 0) threads = csv__cpu_count();
+
+    Csv_Chunk *chunks = CSV_REALLOC(NULL, threads*sizeof(*chunks));
+    void **states = CSV_REALLOC(NULL, threads*sizeof(*states));
+    // Every state starts on a cache line of its own, so threads don't fight over the lines of their neighbours
+    size_t stride = (reducer->state_size + 63) & ~(size_t)63;
+    char *storage = CSV_REALLOC(NULL, (threads - 1)*stride + 64);
+    assert(chunks != NULL && states != NULL && storage != NULL && "Buy more RAM lol");
+    char *aligned = storage + (64 - (uintptr_t)storage%64)%64;
+    states[0] = result;
+    for (size_t i = 1; i < threads; i++) states[i] = aligned + (i - 1)*stride;
+
+    csv__split_chunks(file, config, chunks, threads, true);
+    Csv__Reduce_Pass pass = { .chunks = chunks, .states = states, .reducer = reducer, .config = config, .user = user };
+    csv__run_tasks(threads, csv__reduce_task, &pass);
+    for (size_t i = 1; i < threads; i++) reducer->merge(result, states[i], user);
+
+    CSV_FREE(storage);
+    CSV_FREE(states);
+    CSV_FREE(chunks);
+}
+
+size_t csv_count_rows(Csv_String_View file, Csv_Config config) {
+    Csv__Row_Count count = csv__count_row_delims(csv_sv_data(file), csv_sv_count(file), config);
+    // The last row doesn't need a delimiter
+    return count.rows[0] + (csv_sv_count(file) > 0 && !count.ends_row[0]);
+}
+
+typedef struct {
+    const char *data;
+    Csv_Config config;
+    size_t *starts;
+    Csv__Row_Count *counts;
+} Csv__Row_Count_Pass;
+
+static void csv__row_count_piece_task(size_t task, void *arg) {
+    Csv__Row_Count_Pass *pass = arg;
+    size_t start = pass->starts[task];
+    pass->counts[task] = csv__count_row_delims(pass->data + start, pass->starts[task + 1] - start, pass->config);
+}
+
+size_t csv_count_rows_parallel(Csv_String_View file, Csv_Config config, size_t threads) {
+    if (threads == 0) threads = csv__cpu_count();
+    size_t size = csv_sv_count(file);
+
+    size_t *starts = CSV_REALLOC(NULL, (threads + 1)*sizeof(*starts));
+    Csv__Row_Count *counts = CSV_REALLOC(NULL, threads*sizeof(*counts));
+    assert(starts != NULL && counts != NULL && "Buy more RAM lol");
+    csv__split_guesses(csv_sv_data(file), size, config, starts, threads);
+
+    Csv__Row_Count_Pass pass = { .data = csv_sv_data(file), .config = config, .starts = starts, .counts = counts };
+    csv__run_tasks(threads, csv__row_count_piece_task, &pass);
+
+    // Same prefix XOR as csv_split_chunks() picks the count that matches the real quote state of each piece
+    size_t rows = 0;
+    bool ends_row = false;
+    uint64_t quoted = 0;
+    for (size_t i = 0; i < threads; i++) {
+        rows += counts[i].rows[quoted & 1];
+        if (starts[i + 1] > starts[i]) ends_row = counts[i].ends_row[quoted & 1];
+        quoted ^= counts[i].in_quote;
+    }
+
+    CSV_FREE(starts);
+    CSV_FREE(counts);
+    return rows + (size > 0 && !ends_row);
+}
+
+// Offset of the start of row `skip` of `data`, counting from 0. Returns `count` if there are not that many rows.
+// Same popcount as csv_count_rows(), and the row that ends the skip is picked out of its block with a select.
+static size_t csv__skip_rows(const char *data, size_t count, uint64_t skip, Csv_Config config) {
+    if (skip == 0) return 0;
+    Csv__Scan_State state = {0};
+    Csv__Block masks;
+    for (size_t i = 0; i < count; i += 64) {
+        size_t n = count - i < 64 ? count - i : 64;
+        if (n == 64) csv__classify_block(data + i, config, &masks);
+        else         csv__classify_tail(data + i, n, config, &masks);
+        uint64_t ends = masks.row_delim & ~csv__quoted_mask(&masks, n, &state);
+        size_t found = csv__popcount64(ends);
+        if (found >= skip) {
+            size_t end = i + csv__select64(ends, skip - 1) + 1;
+            return end < count ? end : count;
+        }
+        skip -= found;
+    }
+    return count;
+}
+
+typedef struct {
+    Csv_Row_Index *index;
+    const char *data;
+    Csv_Chunk *chunks;
+    uint64_t *first_rows;  // Row number of the first row of each chunk
+    Csv_Config config;
+} Csv__Row_Index_Pass;
+
+static void csv__row_count_task(size_t task, void *arg) {
+    Csv__Row_Index_Pass *pass = arg;
+    pass->first_rows[task + 1] = csv_count_rows(pass->chunks[task].rows, pass->config);
+}
+
+static void csv__row_sample_task(size_t task, void *arg) {
+    Csv__Row_Index_Pass *pass = arg;
+    Csv_Row_Index *index = pass->index;
+    const char *data = csv_sv_data(pass->chunks[task].rows);
+    size_t count = csv_sv_count(pass->chunks[task].rows);
+    uint64_t row = pass->first_rows[task];
+    uint64_t end = pass->first_rows[task + 1];
+
+    // Every chunk fills its own part of the offsets, starting at the first multiple of the stride it contains
+    uint64_t sample = (row + index->stride - 1)/index->stride*index->stride;
+    size_t i = csv__skip_rows(data, count, sample - row, pass->config);
+    while (sample < end) {
+        index->offsets[sample/index->stride] = (uint64_t)(data + i - pass->data);
+        sample += index->stride;
+        if (sample < end) i += csv__skip_rows(data + i, count - i, index->stride, pass->config);
+    }
+}
+
+void csv_row_index_build(Csv_Row_Index *index, Csv_String_View file, Csv_Config config, size_t stride, size_t threads) {
+    if (stride == 0) stride = CSV_ROW_INDEX_STRIDE;
+    if (threads == 0) threads = csv__cpu_count();
+
+    Csv_Chunk *chunks = CSV_REALLOC(NULL, threads*sizeof(*chunks));
+    uint64_t *first_rows = CSV_REALLOC(NULL, (threads + 1)*sizeof(*first_rows));
+    assert(chunks != NULL && first_rows != NULL && "Buy more RAM lol");
+    csv__split_chunks(file, config, chunks, threads, true);
+
+    // Pass 1: rows per chunk, in parallel. A prefix sum turns them into the number of the first row of every chunk.
+    Csv__Row_Index_Pass pass = {
+        .index = index,
+        .data = csv_sv_data(file),
+        .chunks = chunks,
+        .first_rows = first_rows,
+        .config = config,
+    };
+    csv__run_tasks(threads, csv__row_count_task, &pass);
+    first_rows[0] = 0;
+    for (size_t i = 0; i < threads; i++) first_rows[i + 1] += first_rows[i];
+
+    index->stride = stride;
+    index->rows = first_rows[threads];
+    index->file_size = csv_sv_count(file);
+    index->config = config;
+    index->count = (size_t)((index->rows + stride - 1)/stride);
+    index->offsets = CSV_REALLOC(index->offsets, (index->count > 0 ? index->count : 1)*sizeof(*index->offsets));
+    assert(index->offsets != NULL && "Buy more RAM lol");
+
+    // Pass 2: every chunk records the rows of its part that land on the stride, in parallel
+    csv__run_tasks(threads, csv__row_sample_task, &pass);
+
+    CSV_FREE(chunks);
+    CSV_FREE(first_rows);
+}
+
+// 2: nanosecond modification times
+#define CSV__ROW_INDEX_MAGIC "CSVRIDX2"
+
+// Modification time in nanoseconds, at whatever resolution the platform and filesystem keep it
+static int64_t csv__mtime_ns(const struct stat *st) {
+#if defined(__APPLE__)
+    return (int64_t)st->st_mtimespec.tv_sec*1000000000 + st->st_mtimespec.tv_nsec;
+#elif defined(_WIN32)
+    return (int64_t)st->st_mtime*1000000000;
+#else
+    return (int64_t)st->st_mtim.tv_sec*1000000000 + st->st_mtim.tv_nsec;
+#endif
+}
+
+bool csv_row_index_stamp(Csv_Row_Index *index, const char *csv_path) {
+    struct stat st;
+    if (stat(csv_path, &st) < 0) return false;
+    index->file_mtime_ns = csv__mtime_ns(&st);
+    return true;
+}
+
+static void csv__put_u64(FILE *f, uint64_t x) {
+    unsigned char bytes[8];
+    for (int i = 0; i < 8; i++) bytes[i] = (unsigned char)(x >> 8*i);
+    fwrite(bytes, 1, sizeof(bytes), f);
+}
+
+static bool csv__get_u64(const unsigned char **p, const unsigned char *end, uint64_t *x) {
+    if (end - *p < 8) return false;
+    *x = 0;
+    for (int i = 0; i < 8; i++) *x |= (uint64_t)(*p)[i] << 8*i;
+    *p += 8;
+    return true;
+}
+
+// LEB128: 7 bits per byte, high bit set on all but the last
+static void csv__put_varint(FILE *f, uint64_t x) {
+    unsigned char bytes[10];
+    size_t n = 0;
+    do {
+        bytes[n] = x & 0x7F;
+        x >>= 7;
+        if (x != 0) bytes[n] |= 0x80;
+        n += 1;
+    } while (x != 0);
+    fwrite(bytes, 1, n, f);
+}
+
+static bool csv__get_varint(const unsigned char **p, const unsigned char *end, uint64_t *x) {
+    *x = 0;
+    for (int shift = 0; shift < 64 && *p < end; shift += 7) {
+        unsigned char byte = *(*p)++;
+        *x |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+bool csv_row_index_save(Csv_Row_Index *index, const char *sidecar_path, const char *csv_path) {
+    struct stat st;
+    if (stat(csv_path, &st) < 0) return false;
+    bool stamped = index->file_mtime_ns != 0;
+    if ((uint64_t)st.st_size != index->file_size || (stamped && csv__mtime_ns(&st) != index->file_mtime_ns)) {
+        // The index was built from something else than what's at `csv_path` now
+        errno = EINVAL;
+        return false;
+    }
+    index->file_mtime_ns = csv__mtime_ns(&st);
+
+    FILE *f = fopen(sidecar_path, "wb");
+    if (f == NULL) return false;
+    fwrite(CSV__ROW_INDEX_MAGIC, 1, 8, f);
+    csv__put_u64(f, index->file_size);
+    csv__put_u64(f, (uint64_t)index->file_mtime_ns);
+    fwrite(&index->config, 1, sizeof(index->config), f);
+    csv__put_u64(f, index->stride);
+    csv__put_u64(f, index->rows);
+    csv__put_u64(f, index->count);
+    // Offsets only go up, and the gaps between them are small numbers that take a byte or two each
+    uint64_t prev = 0;
+    for (size_t i = 0; i < index->count; i++) {
+        csv__put_varint(f, index->offsets[i] - prev);
+        prev = index->offsets[i];
+    }
+    bool ok = !ferror(f);
+    int saved = errno;
+    if (fclose(f) != 0) ok = false;
+    else errno = saved;
+    return ok;
+}
+
+bool csv_row_index_load(Csv_Row_Index *index, const char *sidecar_path, const char *csv_path, Csv_Config config) {
+    struct stat st;
+    if (stat(csv_path, &st) < 0) return false;
+
+    FILE *f = fopen(sidecar_path, "rb");
+    if (f == NULL) return false;
+    unsigned char *data = NULL;
+    size_t size = 0;
+    size_t capacity = 0;
+    for (;;) {
+        if (size == capacity) {
+            capacity = capacity == 0 ? 4096 : capacity*2;
+            data = CSV_REALLOC(data, capacity);
+            assert(data != NULL && "Buy more RAM lol");
+        }
+        size_t n = fread(data + size, 1, capacity - size, f);
+        if (n == 0) break;
+        size += n;
+    }
+    bool ok = !ferror(f);
+    fclose(f);
+
+    const unsigned char *p = data;
+    const unsigned char *end = data + size;
+    uint64_t file_size, file_mtime_ns, stride, rows, count;
+    Csv_Config stored = {0};
+    ok = ok && size >= 8 + sizeof(stored) && memcmp(p, CSV__ROW_INDEX_MAGIC, 8) == 0;
+    if (ok) p += 8;
+    ok = ok && csv__get_u64(&p, end, &file_size) && csv__get_u64(&p, end, &file_mtime_ns);
+    if (ok && end - p >= (ptrdiff_t)sizeof(stored)) {
+        memcpy(&stored, p, sizeof(stored));
+        p += sizeof(stored);
+    } else {
+        ok = false;
+    }
+    ok = ok && csv__get_u64(&p, end, &stride) && csv__get_u64(&p, end, &rows) && csv__get_u64(&p, end, &count);
+    ok = ok && stride > 0 && count == (rows + stride - 1)/stride && count <= (uint64_t)(end - p);
+
+    // Stale or for another dialect: the offsets would point at the wrong rows
+    ok = ok && file_size == (uint64_t)st.st_size && (int64_t)file_mtime_ns == csv__mtime_ns(&st);
+    ok = ok && memcmp(&stored, &config, sizeof(config)) == 0;
+
+    // Decoded on the side, so a corrupt sidecar leaves the index as it was
+    uint64_t *offsets = NULL;
+    if (ok) {
+        offsets = CSV_REALLOC(NULL, (count > 0 ? count : 1)*sizeof(*offsets));
+        assert(offsets != NULL && "Buy more RAM lol");
+        uint64_t offset = 0;
+        for (uint64_t i = 0; i < count && ok; i++) {
+            uint64_t delta = 0;
+            ok = csv__get_varint(&p, end, &delta);
+            offset += delta;
+            ok = ok && offset < file_size;
+            offsets[i] = offset;
+        }
+    }
+    CSV_FREE(data);
+    if (!ok) {
+        CSV_FREE(offsets);
+        errno = EINVAL;
+        return false;
+    }
+
+    CSV_FREE(index->offsets);
+    index->offsets = offsets;
+    index->count = (size_t)count;
+    index->stride = stride;
+    index->rows = rows;
+    index->file_size = file_size;
+    index->file_mtime_ns = (int64_t)file_mtime_ns;
+    index->config = config;
     return true;
 }
 
-void csv__fill_struct(void *out_v, Csv_String_View *row, Csv_Config config, const Csv__Field *fields, size_t fields_count) {
-    char *out = out_v;
-    Csv_String_View item = {0};
-    for (size_t i = 0; i < fields_count && csv_next_item(row, &item, config); i++) {
-        Csv__Field field = fields[i];
-        void *field_loc = out + field.offset;
-
-        static_assert(CSV_SUPPORTED_TYPES == 3, "Exhaustive handling of supported types in csv__fill_struct()");
-        if (strcmp(field.type, "int") == 0) {
-            int val = atoi(csv_sv_data(item));
-            memcpy(field_loc, &val, sizeof(val));
-        } else if (strcmp(field.type, "long") == 0) {
-            long val = atol(csv_sv_data(item));
-            memcpy(field_loc, &val, sizeof(val));
-        } else if (strcmp(field.type, "float") == 0) {
-            float val = (float)atof(csv_sv_data(item));
-            memcpy(field_loc, &val, sizeof(val));
-        } else if (strcmp(field.type, "string_view") == 0) {
-            memcpy(field_loc, &item, sizeof(Csv_String_View));
+// Offset of the start of row `row`, or the end of the file if it's past the last row
+static size_t csv__row_index_find(const Csv_Row_Index *index, Csv_String_View file, uint64_t row) {
+    if (row >= index->rows) return csv_sv_count(file);
+    size_t start = (size_t)index->offsets[row/index->stride];
+    return start + csv__skip_rows(csv_sv_data(file) + start, csv_sv_count(file) - start, row%index->stride, index->config);
+}
+
+bool csv_row_index_seek(const Csv_Row_Index *index, Csv_String_View file, uint64_t first, uint64_t count, Csv_String_View *rows) {
+    assert(csv_sv_count(file) == index->file_size && "The index was built for another file");
+    if (first >= index->rows) return false;
+    size_t start = csv__row_index_find(index, file, first);
+    size_t end = count < index->rows - first ? csv__row_index_find(index, file, first + count) : csv_sv_count(file);
+    *rows = csv_sv_from_parts((char *)csv_sv_data(file) + start, end - start);
+    return true;
+}
+
+void csv_row_index_free(Csv_Row_Index *index) {
+    CSV_FREE(index->offsets);
+    memset(index, 0, sizeof(*index));
+}
+
+CSV__INLINE bool csv__next_item_ex(Csv_String_View *row, Csv_Item *item, Csv_Config config, int isa) {
+    if (csv_sv_count(*row) == 0) return false;
+    const char *data = csv_sv_data(*row);
+    size_t count = csv_sv_count(*row);
+
+    CSV__STAT(csv__stats.items += 1);
+    CSV__STAT_TIME(uint64_t start = csv__now_ns());
+
+    item->quoted = data[0] == config.quote;
+    item->escaped = false;
+    if (!item->quoted) {
+        item->view = csv__sv_chop_at(row, csv__find_byte_isa(data, count, config.col_delim, isa));
+        CSV__STAT_TIME(csv__stats.item_ns += csv__now_ns() - start);
+        return true;
+    }
+    CSV__STAT(csv__stats.quoted_items += 1);
+
+    // Skip starting quote, then jump from one quote or escape to the next. Noting the escapes on the way is free.
+    size_t i = 1;
+    for (;;) {
+        i += csv__find_byte2_isa(data + i, count - i, config.quote, config.escape, isa);
+        if (i >= count) break;
+        // A doubled quote is an escaped quote, anything else ends the item
+        if (data[i] == config.quote && (config.escape != config.quote || i + 1 >= count || data[i + 1] != config.quote)) break;
+        item->escaped = true;
+        CSV__STAT(csv__stats.escapes += 1);
+        // The escape and the character it escapes
+        i = i + 2 < count ? i + 2 : count;
+    }
+    item->view = csv_sv_from_parts((char *)data + 1, i - 1);
+
+    // Skip ending quote (unless the row ended before it), and the column delimiter after it
+    if (i < count) i += 1;
+    if (i < count && data[i] == config.col_delim) i += 1;
+    csv_sv_data(*row)  += i;
+    csv_sv_count(*row) -= i;
+    CSV__STAT_TIME(csv__stats.item_ns += csv__now_ns() - start);
+    return true;
+}
+
+CSV__INLINE bool csv__next_item(Csv_String_View *row, Csv_String_View *item, Csv_Config config, int isa) {
+    Csv_Item it;
+    if (!csv__next_item_ex(row, &it, config, isa)) return false;
+    *item = it.view;
+    return true;
+}
+
+bool csv_next_item_ex(Csv_String_View *row, Csv_Item *item, Csv_Config config) {
+    return csv__next_item_ex(row, item, config, CSV__ISA_RUNTIME);
+}
+
+bool csv_next_item(Csv_String_View *row, Csv_String_View *item, Csv_Config config) {
+    return csv__next_item(row, item, config, CSV__ISA_RUNTIME);
+}
+
+// Dialect functions are stamped once per instruction set, like the kernels, so the constants of the dialect and the
+// wide registers both make it into the inner loops
+#if defined(CSV__DISPATCH)
+#define CSV__DIALECT_VARIANTS(prefix, config)                      \
+    CSV__DIALECT_VARIANT(prefix, sse2,   CSV__ISA_SSE2,   , config) \
+    CSV__DIALECT_VARIANT(prefix, avx2,   CSV__ISA_AVX2,   CSV__TARGET_AVX2, config) \
+    CSV__DIALECT_VARIANT(prefix, avx512, CSV__ISA_AVX512, CSV__TARGET_AVX512, config)
+#define CSV__DIALECT_CALL(name, args)                             \
+    switch (csv__kernels()->isa) {                                \
+    case CSV__ISA_AVX512: return name##__avx512 args;             \
+    case CSV__ISA_AVX2:   return name##__avx2 args;               \
+    default:              return name##__sse2 args;               \
+    }
+#else
+#define CSV__DIALECT_VARIANTS(prefix, config) CSV__DIALECT_VARIANT(prefix, base, CSV__ISA, , config)
+#define CSV__DIALECT_CALL(name, args) return name##__base args;
+#endif // CSV__DISPATCH
+
+#define CSV__DIALECT_VARIANT(prefix, suffix, isa, target, config)                                        \
+    target static bool prefix##_next_row__##suffix(Csv_String_View *file, Csv_String_View *row) {        \
+        return csv__next_row(file, row, config, isa);                                                    \
+    }                                                                                                    \
+    target static bool prefix##_next_item__##suffix(Csv_String_View *row, Csv_String_View *item) {       \
+        return csv__next_item(row, item, config, isa);                                                   \
+    }                                                                                                    \
+    target static bool prefix##_next_item_ex__##suffix(Csv_String_View *row, Csv_Item *item) {           \
+        return csv__next_item_ex(row, item, config, isa);                                                \
+    }
+
+CSV_DEFINE_DIALECT(csv_comma,   ',',  '\n', '"', '\\')
+CSV_DEFINE_DIALECT(csv_rfc4180, ',',  '\n', '"', '"')
+CSV_DEFINE_DIALECT(csv_tsv,     '\t', '\n', '"', '\\')
+CSV_DEFINE_DIALECT(csv_psv,     '|',  '\n', '"', '\\')
+
+void csv_skip_items(Csv_String_View *row, size_t count, Csv_Config config) {
+    // A couple of unquoted items are quicker to skip one delimiter search at a time
+    while (count > 0 && count <= 2 && csv_sv_count(*row) > 0 && csv_sv_data(*row)[0] != config.quote) {
+        csv_sv_chop_by_delim(row, config.col_delim);
+        count -= 1;
+    }
+    if (count == 0) return;
+    const char *data = csv_sv_data(*row);
+    size_t size = csv_sv_count(*row);
+
+    // Every item ends at a column delimiter outside of quotes, so skipping `count` items is finding the
+    // `count`th of those. Whole blocks that don't have enough are skipped with a popcount.
+    Csv__Scan_State state = {0};
+    Csv__Block masks;
+    size_t i = 0;
+    while (i < size) {
+        size_t n = size - i < 64 ? size - i : 64;
+        if (n == 64) csv__classify_block(data + i, config, &masks);
+        else         csv__classify_tail(data + i, n, config, &masks);
+        uint64_t ends = masks.col_delim & ~csv__quoted_mask(&masks, n, &state);
+        size_t found = csv__popcount64(ends);
+        if (found >= count) {
+            i += csv__select64(ends, count - 1) + 1;
+            csv_sv_data(*row)  += i;
+            csv_sv_count(*row) -= i;
+            return;
+        }
+        count -= found;
+        i += n;
+    }
+    csv_sv_data(*row)  += size;
+    csv_sv_count(*row) -= size;
+}
+
+bool csv_next_projected_item(Csv_String_View *row, const Csv_Projection *projection, size_t *cursor, Csv_String_View *item, Csv_Config config) {
+    if (*cursor >= projection->count) return false;
+    size_t column = *cursor == 0 ? 0 : projection->columns[*cursor - 1] + 1;
+    assert(projection->columns[*cursor] >= column && "Projected columns must be in increasing order");
+    csv_skip_items(row, projection->columns[*cursor] - column, config);
+    if (!csv_next_item(row, item, config)) return false;
+    *cursor += 1;
+    return true;
+}
+
+struct Csv__Arena_Block {
+    Csv__Arena_Block *next;
+    size_t count;
+    size_t capacity;
+    char data[];
+};
+
+static Csv__Arena_Block *csv__arena_block_new(size_t size) {
+    size_t capacity = size > CSV_ARENA_BLOCK_SIZE ? size : CSV_ARENA_BLOCK_SIZE;
+    Csv__Arena_Block *block = CSV_REALLOC(NULL, sizeof(*block) + capacity);
+    assert(block != NULL && "Buy more RAM lol");
+    block->next = NULL;
+    block->count = 0;
+    block->capacity = capacity;
+    return block;
+}
+
+char *csv_arena_alloc(Csv_Arena *arena, size_t size) {
+    if (arena->current == NULL) {
+        arena->first = arena->current = csv__arena_block_new(size);
+    }
+    while (arena->current->count + size > arena->current->capacity) {
+        Csv__Arena_Block *next = arena->current->next;
+        // Blocks after the current one are left over from before the last reset
+        if (next == NULL || next->capacity < size) {
+            Csv__Arena_Block *block = csv__arena_block_new(size);
+            block->next = next;
+            arena->current->next = block;
+            next = block;
+        }
+        next->count = 0;
+        arena->current = next;
+    }
+    char *result = arena->current->data + arena->current->count;
+    arena->current->count += size;
+    return result;
+}
+
+void csv_arena_reset(Csv_Arena *arena) {
+    arena->current = arena->first;
+    if (arena->current) arena->current->count = 0;
+}
+
+void csv_arena_free(Csv_Arena *arena) {
+    Csv__Arena_Block *block = arena->first;
+    while (block != NULL) {
+        Csv__Arena_Block *next = block->next;
+        CSV_FREE(block);
+        block = next;
+    }
+    arena->first = arena->current = NULL;
+}
+
+Csv_String_View csv_unescape(Csv_Arena *arena, Csv_Item item, Csv_Config config) {
+    if (!item.escaped) return item.view;
+    size_t count = csv_sv_count(item.view);
+    CSV__STAT_TIME(uint64_t start = csv__now_ns());
+    char *out = csv_arena_alloc(arena, count);
+    size_t written = csv__unescape_to(out, csv_sv_data(item.view), count, config);
+    CSV__STAT_TIME(csv__stats.unescape_ns += csv__now_ns() - start);
+    return csv_sv_from_parts(out, written);
+}
+
+static inline bool csv__is_digit(char c) {
+    return (unsigned char)(c - '0') < 10;
+}
+
+static inline bool csv__is_blank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ || defined(_M_X64) || defined(_M_IX86)
+#define CSV__SWAR
+#endif
+
+#if defined(CSV__SWAR)
+static inline uint64_t csv__load8(const char *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// True if all 8 bytes of `v` are ASCII digits
+static inline bool csv__is_8_digits(uint64_t v) {
+    return ((v & 0xF0F0F0F0F0F0F0F0ULL) | (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
+
+// Value of 8 ASCII digits, first digit in the lowest byte. Combines pairs, then quads, then the two halves,
+// with three multiplications instead of eight.
+static inline uint32_t csv__parse_8_digits(uint64_t v) {
+    const uint64_t mask = 0x000000FF000000FFULL;
+    const uint64_t mul1 = 0x000F424000000064ULL; // 100 + (1000000 << 32)
+    const uint64_t mul2 = 0x0000271000000001ULL; // 1 + (10000 << 32)
+    v -= 0x3030303030303030ULL;
+    v = v*10 + (v >> 8);
+    v = ((v & mask)*mul1 + ((v >> 16) & mask)*mul2) >> 32;
+    return (uint32_t)v;
+}
+#endif // CSV__SWAR
+
+// Reads the digits at `*p` into `*mantissa`, stopping at 19 digits (the most that always fit in 64 bits).
+// Returns how many digits were read and sets `*dropped` to how many of them didn't fit.
+static inline size_t csv__read_digits(const char **p, const char *end, uint64_t *mantissa, size_t *digits, size_t *dropped) {
+    const char *start = *p;
+    const char *q = *p;
+#if defined(CSV__SWAR)
+    while (end - q >= 8 && *digits + 8 <= 19 && csv__is_8_digits(csv__load8(q))) {
+        *mantissa = *mantissa*100000000 + csv__parse_8_digits(csv__load8(q));
+        *digits += 8;
+        q += 8;
+    }
+#endif // CSV__SWAR
+    while (q < end && csv__is_digit(*q)) {
+        if (*digits < 19) {
+            *mantissa = *mantissa*10 + (uint64_t)(*q - '0');
+            *digits += 1;
+        } else {
+            *dropped += 1;
+        }
+        q += 1;
+    }
+    *p = q;
+    return q - start;
+}
+
+Csv_Parse_Result csv_parse_i64(Csv_String_View sv, int64_t *out) {
+    const char *p = csv_sv_data(sv);
+    const char *end = p + csv_sv_count(sv);
+    while (p < end && csv__is_blank(*p)) p += 1;
+    while (end > p && csv__is_blank(end[-1])) end -= 1;
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p += 1;
+    }
+    if (p == end) return CSV_PARSE_INVALID;
+    // Leading zeros don't count towards the 19 digits
+    while (end - p > 1 && *p == '0') p += 1;
+
+    uint64_t value = 0;
+    size_t digits = 0;
+    size_t dropped = 0;
+    if (csv__read_digits(&p, end, &value, &digits, &dropped) == 0 || p != end) return CSV_PARSE_INVALID;
+
+    if (dropped > 0) {
+        // 20 digits can still fit in a uint64_t, anything longer can't
+        if (dropped > 1) return CSV_PARSE_OVERFLOW;
+        uint64_t last = (uint64_t)(end[-1] - '0');
+        if (value > (UINT64_MAX - last)/10) return CSV_PARSE_OVERFLOW;
+        value = value*10 + last;
+    }
+
+    if (negative) {
+        if (value > (uint64_t)INT64_MAX + 1) return CSV_PARSE_OVERFLOW;
+        *out = (int64_t)(0 - value);
+    } else {
+        if (value > (uint64_t)INT64_MAX) return CSV_PARSE_OVERFLOW;
+        *out = (int64_t)value;
+    }
+    return CSV_PARSE_OK;
+}
+
+// strtod() follows LC_NUMERIC, which may want ',' for the decimal point, so it runs in a "C" locale of our own.
+// The locale is made once and shared; threads that race to make it keep whichever got stored first.
+#if defined(_WIN32)
+#    include <locale.h>
+typedef _locale_t Csv__Locale;
+#else
+#    include <locale.h>
+#    if defined(__APPLE__)
+#        include <xlocale.h>
+#    endif
+typedef locale_t Csv__Locale;
+#endif
+
+static Csv__Locale csv__c_locale(void) {
+    static Csv__Locale c_locale;
+#if defined(_MSC_VER) && !defined(__clang__)
+    Csv__Locale locale = _InterlockedCompareExchangePointer((void *volatile *)&c_locale, NULL, NULL);
+    if (locale == NULL) {
+        Csv__Locale made = _create_locale(LC_ALL, "C");
+        assert(made != NULL && "Buy more RAM lol");
+        locale = _InterlockedCompareExchangePointer((void *volatile *)&c_locale, made, NULL);
+        if (locale == NULL) locale = made;
+        else _free_locale(made);
+    }
+#else
+    Csv__Locale locale = __atomic_load_n(&c_locale, __ATOMIC_ACQUIRE);
+    if (locale == (Csv__Locale)0) {
+#    if defined(_WIN32)
+        Csv__Locale made = _create_locale(LC_ALL, "C");
+#    else
+        Csv__Locale made = newlocale(LC_ALL_MASK, "C", (Csv__Locale)0);
+#    endif
+        assert(made != (Csv__Locale)0 && "Buy more RAM lol");
+        if (__atomic_compare_exchange_n(&c_locale, &locale, made, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            locale = made;
+        } else {
+#    if defined(_WIN32)
+            _free_locale(made);
+#    else
+            freelocale(made);
+#    endif
+        }
+    }
+#endif
+    return locale;
+}
+
+static double csv__strtod_c(const char *text, char **end) {
+#if defined(_WIN32)
+    return _strtod_l(text, end, csv__c_locale());
+#else
+    // Only switches the calling thread
+    Csv__Locale previous = uselocale(csv__c_locale());
+    double value = strtod(text, end);
+    uselocale(previous);
+    return value;
+#endif
+}
+
+// inf, nan, and the few numbers past 19 digits that Eisel-Lemire can't settle go through strtod() on a NUL-terminated copy
+static Csv_Parse_Result csv__parse_f64_slow(const char *p, const char *end, double *out) {
+    char small[128];
+    size_t count = end - p;
+    char *buffer = count < sizeof(small) ? small : CSV_REALLOC(NULL, count + 1);
+    assert(buffer != NULL && "Buy more RAM lol");
+    memcpy(buffer, p, count);
+    buffer[count] = '\0';
+
+    char *parsed_end = NULL;
+    errno = 0;
+    double value = csv__strtod_c(buffer, &parsed_end);
+    Csv_Parse_Result result = CSV_PARSE_OK;
+    if (parsed_end != buffer + count || count == 0) {
+        result = CSV_PARSE_INVALID;
+    } else if (errno == ERANGE && (value == HUGE_VAL || value == -HUGE_VAL)) {
+        result = CSV_PARSE_OVERFLOW;
+    } else {
+        *out = value;
+    }
+
+    if (buffer != small) CSV_FREE(buffer);
+    return result;
+}
+
+// Powers of ten that are exact doubles
+static const double csv__exact_powers[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+// 5^q for q in [-342, 324] in 128 bits, shifted so the top bit is set: truncated for q >= 0, and rounded up then
+// truncated for q < 0. This is the table of fast_float, which the proof that Eisel-Lemire needs no fallback is for.
+// csv_parse_f64() only goes up to 5^308; the rest is for the subnormals of csv_write_f64().
+#define CSV__POW5_MIN -342
+#define CSV__POW5_MAX 324
+static const uint64_t csv__powers_of_five[][2] = {
+    {0xEEF453D6923BD65AULL, 0x113FAA2906A13B3FULL}, {0x9558B4661B6565F8ULL, 0x4AC7CA59A424C507ULL},
+    {0xBAAEE17FA23EBF76ULL, 0x5D79BCF00D2DF649ULL}, {0xE95A99DF8ACE6F53ULL, 0xF4D82C2C107973DCULL},
+    {0x91D8A02BB6C10594ULL, 0x79071B9B8A4BE869ULL}, {0xB64EC836A47146F9ULL, 0x9748E2826CDEE284ULL},
+    {0xE3E27A444D8D98B7ULL, 0xFD1B1B2308169B25ULL}, {0x8E6D8C6AB0787F72ULL, 0xFE30F0F5E50E20F7ULL},
+    {0xB208EF855C969F4FULL, 0xBDBD2D335E51A935ULL}, {0xDE8B2B66B3BC4723ULL, 0xAD2C788035E61382ULL},
+    {0x8B16FB203055AC76ULL, 0x4C3BCB5021AFCC31ULL}, {0xADDCB9E83C6B1793ULL, 0xDF4ABE242A1BBF3DULL},
+    {0xD953E8624B85DD78ULL, 0xD71D6DAD34A2AF0DULL}, {0x87D4713D6F33AA6BULL, 0x8672648C40E5AD68ULL},
+    {0xA9C98D8CCB009506ULL, 0x680EFDAF511F18C2ULL}, {0xD43BF0EFFDC0BA48ULL, 0x0212BD1B2566DEF2ULL},
+    {0x84A57695FE98746DULL, 0x014BB630F7604B57ULL}, {0xA5CED43B7E3E9188ULL, 0x419EA3BD35385E2DULL},
+    {0xCF42894A5DCE35EAULL, 0x52064CAC828675B9ULL}, {0x818995CE7AA0E1B2ULL, 0x7343EFEBD1940993ULL},
+    {0xA1EBFB4219491A1FULL, 0x1014EBE6C5F90BF8ULL}, {0xCA66FA129F9B60A6ULL, 0xD41A26E077774EF6ULL},
+    {0xFD00B897478238D0ULL, 0x8920B098955522B4ULL}, {0x9E20735E8CB16382ULL, 0x55B46E5F5D5535B0ULL},
+    {0xC5A890362FDDBC62ULL, 0xEB2189F734AA831DULL}, {0xF712B443BBD52B7BULL, 0xA5E9EC7501D523E4ULL},
+    {0x9A6BB0AA55653B2DULL, 0x47B233C92125366EULL}, {0xC1069CD4EABE89F8ULL, 0x999EC0BB696E840AULL},
+    {0xF148440A256E2C76ULL, 0xC00670EA43CA250DULL}, {0x96CD2A865764DBCAULL, 0x380406926A5E5728ULL},
+    {0xBC807527ED3E12BCULL, 0xC605083704F5ECF2ULL}, {0xEBA09271E88D976BULL, 0xF7864A44C633682EULL},
+    {0x93445B8731587EA3ULL, 0x7AB3EE6AFBE0211DULL}, {0xB8157268FDAE9E4CULL, 0x5960EA05BAD82964ULL},
+    {0xE61ACF033D1A45DFULL, 0x6FB92487298E33BDULL}, {0x8FD0C16206306BABULL, 0xA5D3B6D479F8E056ULL},
+    {0xB3C4F1BA87BC8696ULL, 0x8F48A4899877186CULL}, {0xE0B62E2929ABA83CULL, 0x331ACDABFE94DE87ULL},
+    {0x8C71DCD9BA0B4925ULL, 0x9FF0C08B7F1D0B14ULL}, {0xAF8E5410288E1B6FULL, 0x07ECF0AE5EE44DD9ULL},
+    {0xDB71E91432B1A24AULL, 0xC9E82CD9F69D6150ULL}, {0x892731AC9FAF056EULL, 0xBE311C083A225CD2ULL},
+    {0xAB70FE17C79AC6CAULL, 0x6DBD630A48AAF406ULL}, {0xD64D3D9DB981787DULL, 0x092CBBCCDAD5B108ULL},
+    {0x85F0468293F0EB4EULL, 0x25BBF56008C58EA5ULL}, {0xA76C582338ED2621ULL, 0xAF2AF2B80AF6F24EULL},
+    {0xD1476E2C07286FAAULL, 0x1AF5AF660DB4AEE1ULL}, {0x82CCA4DB847945CAULL, 0x50D98D9FC890ED4DULL},
+    {0xA37FCE126597973CULL, 0xE50FF107BAB528A0ULL}, {0xCC5FC196FEFD7D0CULL, 0x1E53ED49A96272C8ULL},
+    {0xFF77B1FCBEBCDC4FULL, 0x25E8E89C13BB0F7AULL}, {0x9FAACF3DF73609B1ULL, 0x77B191618C54E9ACULL},
+    {0xC795830D75038C1DULL, 0xD59DF5B9EF6A2417ULL}, {0xF97AE3D0D2446F25ULL, 0x4B0573286B44AD1DULL},
+    {0x9BECCE62836AC577ULL, 0x4EE367F9430AEC32ULL}, {0xC2E801FB244576D5ULL, 0x229C41F793CDA73FULL},
+    {0xF3A20279ED56D48AULL, 0x6B43527578C1110FULL}, {0x9845418C345644D6ULL, 0x830A13896B78AAA9ULL},
+    {0xBE5691EF416BD60CULL, 0x23CC986BC656D553ULL}, {0xEDEC366B11C6CB8FULL, 0x2CBFBE86B7EC8AA8ULL},
+    {0x94B3A202EB1C3F39ULL, 0x7BF7D71432F3D6A9ULL}, {0xB9E08A83A5E34F07ULL, 0xDAF5CCD93FB0CC53ULL},
+    {0xE858AD248F5C22C9ULL, 0xD1B3400F8F9CFF68ULL}, {0x91376C36D99995BEULL, 0x23100809B9C21FA1ULL},
+    {0xB58547448FFFFB2DULL, 0xABD40A0C2832A78AULL}, {0xE2E69915B3FFF9F9ULL, 0x16C90C8F323F516CULL},
+    {0x8DD01FAD907FFC3BULL, 0xAE3DA7D97F6792E3ULL}, {0xB1442798F49FFB4AULL, 0x99CD11CFDF41779CULL},
+    {0xDD95317F31C7FA1DULL, 0x40405643D711D583ULL}, {0x8A7D3EEF7F1CFC52ULL, 0x482835EA666B2572ULL},
+    {0xAD1C8EAB5EE43B66ULL, 0xDA3243650005EECFULL}, {0xD863B256369D4A40ULL, 0x90BED43E40076A82ULL},
+    {0x873E4F75E2224E68ULL, 0x5A7744A6E804A291ULL}, {0xA90DE3535AAAE202ULL, 0x711515D0A205CB36ULL},
+    {0xD3515C2831559A83ULL, 0x0D5A5B44CA873E03ULL}, {0x8412D9991ED58091ULL, 0xE858790AFE9486C2ULL},
+    {0xA5178FFF668AE0B6ULL, 0x626E974DBE39A872ULL}, {0xCE5D73FF402D98E3ULL, 0xFB0A3D212DC8128FULL},
+    {0x80FA687F881C7F8EULL, 0x7CE66634BC9D0B99ULL}, {0xA139029F6A239F72ULL, 0x1C1FFFC1EBC44E80ULL},
+    {0xC987434744AC874EULL, 0xA327FFB266B56220ULL}, {0xFBE9141915D7A922ULL, 0x4BF1FF9F0062BAA8ULL},
+    {0x9D71AC8FADA6C9B5ULL, 0x6F773FC3603DB4A9ULL}, {0xC4CE17B399107C22ULL, 0xCB550FB4384D21D3ULL},
+    {0xF6019DA07F549B2BULL, 0x7E2A53A146606A48ULL}, {0x99C102844F94E0FBULL, 0x2EDA7444CBFC426DULL},
+    {0xC0314325637A1939ULL, 0xFA911155FEFB5308ULL}, {0xF03D93EEBC589F88ULL, 0x793555AB7EBA27CAULL},
+    {0x96267C7535B763B5ULL, 0x4BC1558B2F3458DEULL}, {0xBBB01B9283253CA2ULL, 0x9EB1AAEDFB016F16ULL},
+    {0xEA9C227723EE8BCBULL, 0x465E15A979C1CADCULL}, {0x92A1958A7675175FULL, 0x0BFACD89EC191EC9ULL},
+    {0xB749FAED14125D36ULL, 0xCEF980EC671F667BULL}, {0xE51C79A85916F484ULL, 0x82B7E12780E7401AULL},
+    {0x8F31CC0937AE58D2ULL, 0xD1B2ECB8B0908810ULL}, {0xB2FE3F0B8599EF07ULL, 0x861FA7E6DCB4AA15ULL},
+    {0xDFBDCECE67006AC9ULL, 0x67A791E093E1D49AULL}, {0x8BD6A141006042BDULL, 0xE0C8BB2C5C6D24E0ULL},
+    {0xAECC49914078536DULL, 0x58FAE9F773886E18ULL}, {0xDA7F5BF590966848ULL, 0xAF39A475506A899EULL},
+    {0x888F99797A5E012DULL, 0x6D8406C952429603ULL}, {0xAAB37FD7D8F58178ULL, 0xC8E5087BA6D33B83ULL},
+    {0xD5605FCDCF32E1D6ULL, 0xFB1E4A9A90880A64ULL}, {0x855C3BE0A17FCD26ULL, 0x5CF2EEA09A55067FULL},
+    {0xA6B34AD8C9DFC06FULL, 0xF42FAA48C0EA481EULL}, {0xD0601D8EFC57B08BULL, 0xF13B94DAF124DA26ULL},
+    {0x823C12795DB6CE57ULL, 0x76C53D08D6B70858ULL}, {0xA2CB1717B52481EDULL, 0x54768C4B0C64CA6EULL},
+    {0xCB7DDCDDA26DA268ULL, 0xA9942F5DCF7DFD09ULL}, {0xFE5D54150B090B02ULL, 0xD3F93B35435D7C4CULL},
+    {0x9EFA548D26E5A6E1ULL, 0xC47BC5014A1A6DAFULL}, {0xC6B8E9B0709F109AULL, 0x359AB6419CA1091BULL},
+    {0xF867241C8CC6D4C0ULL, 0xC30163D203C94B62ULL}, {0x9B407691D7FC44F8ULL, 0x79E0DE63425DCF1DULL},
+    {0xC21094364DFB5636ULL, 0x985915FC12F542E4ULL}, {0xF294B943E17A2BC4ULL, 0x3E6F5B7B17B2939DULL},
+    {0x979CF3CA6CEC5B5AULL, 0xA705992CEECF9C42ULL}, {0xBD8430BD08277231ULL, 0x50C6FF782A838353ULL},
+    {0xECE53CEC4A314EBDULL, 0xA4F8BF5635246428ULL}, {0x940F4613AE5ED136ULL, 0x871B7795E136BE99ULL},
+    {0xB913179899F68584ULL, 0x28E2557B59846E3FULL}, {0xE757DD7EC07426E5ULL, 0x331AEADA2FE589CFULL},
+    {0x9096EA6F3848984FULL, 0x3FF0D2C85DEF7621ULL}, {0xB4BCA50B065ABE63ULL, 0x0FED077A756B53A9ULL},
+    {0xE1EBCE4DC7F16DFBULL, 0xD3E8495912C62894ULL}, {0x8D3360F09CF6E4BDULL, 0x64712DD7ABBBD95CULL},
+    {0xB080392CC4349DECULL, 0xBD8D794D96AACFB3ULL}, {0xDCA04777F541C567ULL, 0xECF0D7A0FC5583A0ULL},
+    {0x89E42CAAF9491B60ULL, 0xF41686C49DB57244ULL}, {0xAC5D37D5B79B6239ULL, 0x311C2875C522CED5ULL},
+    {0xD77485CB25823AC7ULL, 0x7D633293366B828BULL}, {0x86A8D39EF77164BCULL, 0xAE5DFF9C02033197ULL},
+    {0xA8530886B54DBDEBULL, 0xD9F57F830283FDFCULL}, {0xD267CAA862A12D66ULL, 0xD072DF63C324FD7BULL},
+    {0x8380DEA93DA4BC60ULL, 0x4247CB9E59F71E6DULL}, {0xA46116538D0DEB78ULL, 0x52D9BE85F074E608ULL},
+    {0xCD795BE870516656ULL, 0x67902E276C921F8BULL}, {0x806BD9714632DFF6ULL, 0x00BA1CD8A3DB53B6ULL},
+    {0xA086CFCD97BF97F3ULL, 0x80E8A40ECCD228A4ULL}, {0xC8A883C0FDAF7DF0ULL, 0x6122CD128006B2CDULL},
+    {0xFAD2A4B13D1B5D6CULL, 0x796B805720085F81ULL}, {0x9CC3A6EEC6311A63ULL, 0xCBE3303674053BB0ULL},
+    {0xC3F490AA77BD60FCULL, 0xBEDBFC4411068A9CULL}, {0xF4F1B4D515ACB93BULL, 0xEE92FB5515482D44ULL},
+    {0x991711052D8BF3C5ULL, 0x751BDD152D4D1C4AULL}, {0xBF5CD54678EEF0B6ULL, 0xD262D45A78A0635DULL},
+    {0xEF340A98172AACE4ULL, 0x86FB897116C87C34ULL}, {0x9580869F0E7AAC0EULL, 0xD45D35E6AE3D4DA0ULL},
+    {0xBAE0A846D2195712ULL, 0x8974836059CCA109ULL}, {0xE998D258869FACD7ULL, 0x2BD1A438703FC94BULL},
+    {0x91FF83775423CC06ULL, 0x7B6306A34627DDCFULL}, {0xB67F6455292CBF08ULL, 0x1A3BC84C17B1D542ULL},
+    {0xE41F3D6A7377EECAULL, 0x20CABA5F1D9E4A93ULL}, {0x8E938662882AF53EULL, 0x547EB47B7282EE9CULL},
+    {0xB23867FB2A35B28DULL, 0xE99E619A4F23AA43ULL}, {0xDEC681F9F4C31F31ULL, 0x6405FA00E2EC94D4ULL},
+    {0x8B3C113C38F9F37EULL, 0xDE83BC408DD3DD04ULL}, {0xAE0B158B4738705EULL, 0x9624AB50B148D445ULL},
+    {0xD98DDAEE19068C76ULL, 0x3BADD624DD9B0957ULL}, {0x87F8A8D4CFA417C9ULL, 0xE54CA5D70A80E5D6ULL},
+    {0xA9F6D30A038D1DBCULL, 0x5E9FCF4CCD211F4CULL}, {0xD47487CC8470652BULL, 0x7647C3200069671FULL},
+    {0x84C8D4DFD2C63F3BULL, 0x29ECD9F40041E073ULL}, {0xA5FB0A17C777CF09ULL, 0xF468107100525890ULL},
+    {0xCF79CC9DB955C2CCULL, 0x7182148D4066EEB4ULL}, {0x81AC1FE293D599BFULL, 0xC6F14CD848405530ULL},
+    {0xA21727DB38CB002FULL, 0xB8ADA00E5A506A7CULL}, {0xCA9CF1D206FDC03BULL, 0xA6D90811F0E4851CULL},
+    {0xFD442E4688BD304AULL, 0x908F4A166D1DA663ULL}, {0x9E4A9CEC15763E2EULL, 0x9A598E4E043287FEULL},
+    {0xC5DD44271AD3CDBAULL, 0x40EFF1E1853F29FDULL}, {0xF7549530E188C128ULL, 0xD12BEE59E68EF47CULL},
+    {0x9A94DD3E8CF578B9ULL, 0x82BB74F8301958CEULL}, {0xC13A148E3032D6E7ULL, 0xE36A52363C1FAF01ULL},
+    {0xF18899B1BC3F8CA1ULL, 0xDC44E6C3CB279AC1ULL}, {0x96F5600F15A7B7E5ULL, 0x29AB103A5EF8C0B9ULL},
+    {0xBCB2B812DB11A5DEULL, 0x7415D448F6B6F0E7ULL}, {0xEBDF661791D60F56ULL, 0x111B495B3464AD21ULL},
+    {0x936B9FCEBB25C995ULL, 0xCAB10DD900BEEC34ULL}, {0xB84687C269EF3BFBULL, 0x3D5D514F40EEA742ULL},
+    {0xE65829B3046B0AFAULL, 0x0CB4A5A3112A5112ULL}, {0x8FF71A0FE2C2E6DCULL, 0x47F0E785EABA72ABULL},
+    {0xB3F4E093DB73A093ULL, 0x59ED216765690F56ULL}, {0xE0F218B8D25088B8ULL, 0x306869C13EC3532CULL},
+    {0x8C974F7383725573ULL, 0x1E414218C73A13FBULL}, {0xAFBD2350644EEACFULL, 0xE5D1929EF90898FAULL},
+    {0xDBAC6C247D62A583ULL, 0xDF45F746B74ABF39ULL}, {0x894BC396CE5DA772ULL, 0x6B8BBA8C328EB783ULL},
+    {0xAB9EB47C81F5114FULL, 0x066EA92F3F326564ULL}, {0xD686619BA27255A2ULL, 0xC80A537B0EFEFEBDULL},
+    {0x8613FD0145877585ULL, 0xBD06742CE95F5F36ULL}, {0xA798FC4196E952E7ULL, 0x2C48113823B73704ULL},
+    {0xD17F3B51FCA3A7A0ULL, 0xF75A15862CA504C5ULL}, {0x82EF85133DE648C4ULL, 0x9A984D73DBE722FBULL},
+    {0xA3AB66580D5FDAF5ULL, 0xC13E60D0D2E0EBBAULL}, {0xCC963FEE10B7D1B3ULL, 0x318DF905079926A8ULL},
+    {0xFFBBCFE994E5C61FULL, 0xFDF17746497F7052ULL}, {0x9FD561F1FD0F9BD3ULL, 0xFEB6EA8BEDEFA633ULL},
+    {0xC7CABA6E7C5382C8ULL, 0xFE64A52EE96B8FC0ULL}, {0xF9BD690A1B68637BULL, 0x3DFDCE7AA3C673B0ULL},
+    {0x9C1661A651213E2DULL, 0x06BEA10CA65C084EULL}, {0xC31BFA0FE5698DB8ULL, 0x486E494FCFF30A62ULL},
+    {0xF3E2F893DEC3F126ULL, 0x5A89DBA3C3EFCCFAULL}, {0x986DDB5C6B3A76B7ULL, 0xF89629465A75E01CULL},
+    {0xBE89523386091465ULL, 0xF6BBB397F1135823ULL}, {0xEE2BA6C0678B597FULL, 0x746AA07DED582E2CULL},
+    {0x94DB483840B717EFULL, 0xA8C2A44EB4571CDCULL}, {0xBA121A4650E4DDEBULL, 0x92F34D62616CE413ULL},
+    {0xE896A0D7E51E1566ULL, 0x77B020BAF9C81D17ULL}, {0x915E2486EF32CD60ULL, 0x0ACE1474DC1D122EULL},
+    {0xB5B5ADA8AAFF80B8ULL, 0x0D819992132456BAULL}, {0xE3231912D5BF60E6ULL, 0x10E1FFF697ED6C69ULL},
+    {0x8DF5EFABC5979C8FULL, 0xCA8D3FFA1EF463C1ULL}, {0xB1736B96B6FD83B3ULL, 0xBD308FF8A6B17CB2ULL},
+    {0xDDD0467C64BCE4A0ULL, 0xAC7CB3F6D05DDBDEULL}, {0x8AA22C0DBEF60EE4ULL, 0x6BCDF07A423AA96BULL},
+    {0xAD4AB7112EB3929DULL, 0x86C16C98D2C953C6ULL}, {0xD89D64D57A607744ULL, 0xE871C7BF077BA8B7ULL},
+    {0x87625F056C7C4A8BULL, 0x11471CD764AD4972ULL}, {0xA93AF6C6C79B5D2DULL, 0xD598E40D3DD89BCFULL},
+    {0xD389B47879823479ULL, 0x4AFF1D108D4EC2C3ULL}, {0x843610CB4BF160CBULL, 0xCEDF722A585139BAULL},
+    {0xA54394FE1EEDB8FEULL, 0xC2974EB4EE658828ULL}, {0xCE947A3DA6A9273EULL, 0x733D226229FEEA32ULL},
+    {0x811CCC668829B887ULL, 0x0806357D5A3F525FULL}, {0xA163FF802A3426A8ULL, 0xCA07C2DCB0CF26F7ULL},
+    {0xC9BCFF6034C13052ULL, 0xFC89B393DD02F0B5ULL}, {0xFC2C3F3841F17C67ULL, 0xBBAC2078D443ACE2ULL},
+    {0x9D9BA7832936EDC0ULL, 0xD54B944B84AA4C0DULL}, {0xC5029163F384A931ULL, 0x0A9E795E65D4DF11ULL},
+    {0xF64335BCF065D37DULL, 0x4D4617B5FF4A16D5ULL}, {0x99EA0196163FA42EULL, 0x504BCED1BF8E4E45ULL},
+    {0xC06481FB9BCF8D39ULL, 0xE45EC2862F71E1D6ULL}, {0xF07DA27A82C37088ULL, 0x5D767327BB4E5A4CULL},
+    {0x964E858C91BA2655ULL, 0x3A6A07F8D510F86FULL}, {0xBBE226EFB628AFEAULL, 0x890489F70A55368BULL},
+    {0xEADAB0ABA3B2DBE5ULL, 0x2B45AC74CCEA842EULL}, {0x92C8AE6B464FC96FULL, 0x3B0B8BC90012929DULL},
+    {0xB77ADA0617E3BBCBULL, 0x09CE6EBB40173744ULL}, {0xE55990879DDCAABDULL, 0xCC420A6A101D0515ULL},
+    {0x8F57FA54C2A9EAB6ULL, 0x9FA946824A12232DULL}, {0xB32DF8E9F3546564ULL, 0x47939822DC96ABF9ULL},
+    {0xDFF9772470297EBDULL, 0x59787E2B93BC56F7ULL}, {0x8BFBEA76C619EF36ULL, 0x57EB4EDB3C55B65AULL},
+    {0xAEFAE51477A06B03ULL, 0xEDE622920B6B23F1ULL}, {0xDAB99E59958885C4ULL, 0xE95FAB368E45ECEDULL},
+    {0x88B402F7FD75539BULL, 0x11DBCB0218EBB414ULL}, {0xAAE103B5FCD2A881ULL, 0xD652BDC29F26A119ULL},
+    {0xD59944A37C0752A2ULL, 0x4BE76D3346F0495FULL}, {0x857FCAE62D8493A5ULL, 0x6F70A4400C562DDBULL},
+    {0xA6DFBD9FB8E5B88EULL, 0xCB4CCD500F6BB952ULL}, {0xD097AD07A71F26B2ULL, 0x7E2000A41346A7A7ULL},
+    {0x825ECC24C873782FULL, 0x8ED400668C0C28C8ULL}, {0xA2F67F2DFA90563BULL, 0x728900802F0F32FAULL},
+    {0xCBB41EF979346BCAULL, 0x4F2B40A03AD2FFB9ULL}, {0xFEA126B7D78186BCULL, 0xE2F610C84987BFA8ULL},
+    {0x9F24B832E6B0F436ULL, 0x0DD9CA7D2DF4D7C9ULL}, {0xC6EDE63FA05D3143ULL, 0x91503D1C79720DBBULL},
+    {0xF8A95FCF88747D94ULL, 0x75A44C6397CE912AULL}, {0x9B69DBE1B548CE7CULL, 0xC986AFBE3EE11ABAULL},
+    {0xC24452DA229B021BULL, 0xFBE85BADCE996168ULL}, {0xF2D56790AB41C2A2ULL, 0xFAE27299423FB9C3ULL},
+    {0x97C560BA6B0919A5ULL, 0xDCCD879FC967D41AULL}, {0xBDB6B8E905CB600FULL, 0x5400E987BBC1C920ULL},
+    {0xED246723473E3813ULL, 0x290123E9AAB23B68ULL}, {0x9436C0760C86E30BULL, 0xF9A0B6720AAF6521ULL},
+    {0xB94470938FA89BCEULL, 0xF808E40E8D5B3E69ULL}, {0xE7958CB87392C2C2ULL, 0xB60B1D1230B20E04ULL},
+    {0x90BD77F3483BB9B9ULL, 0xB1C6F22B5E6F48C2ULL}, {0xB4ECD5F01A4AA828ULL, 0x1E38AEB6360B1AF3ULL},
+    {0xE2280B6C20DD5232ULL, 0x25C6DA63C38DE1B0ULL}, {0x8D590723948A535FULL, 0x579C487E5A38AD0EULL},
+    {0xB0AF48EC79ACE837ULL, 0x2D835A9DF0C6D851ULL}, {0xDCDB1B2798182244ULL, 0xF8E431456CF88E65ULL},
+    {0x8A08F0F8BF0F156BULL, 0x1B8E9ECB641B58FFULL}, {0xAC8B2D36EED2DAC5ULL, 0xE272467E3D222F3FULL},
+    {0xD7ADF884AA879177ULL, 0x5B0ED81DCC6ABB0FULL}, {0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4E9ULL},
+    {0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL}, {0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL},
+    {0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL}, {0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL},
+    {0xCDB02555653131B6ULL, 0x3792F412CB06794DULL}, {0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL},
+    {0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL}, {0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL},
+    {0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL}, {0x9CED737BB6C4183DULL, 0x55464DD69685606BULL},
+    {0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL}, {0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL},
+    {0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL}, {0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL},
+    {0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL}, {0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL},
+    {0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL}, {0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL},
+    {0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL}, {0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL},
+    {0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL}, {0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL},
+    {0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL}, {0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL},
+    {0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL}, {0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL},
+    {0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL}, {0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL},
+    {0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL}, {0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL},
+    {0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL}, {0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL},
+    {0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL}, {0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL},
+    {0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL}, {0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL},
+    {0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL}, {0x9E74D1B791E07E48ULL, 0x775EA264CF55347EULL},
+    {0xC612062576589DDAULL, 0x95364AFE032A819EULL}, {0xF79687AED3EEC551ULL, 0x3A83DDBD83F52205ULL},
+    {0x9ABE14CD44753B52ULL, 0xC4926A9672793543ULL}, {0xC16D9A0095928A27ULL, 0x75B7053C0F178294ULL},
+    {0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6339ULL}, {0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E04ULL},
+    {0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF585ULL}, {0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E6ULL},
+    {0x9392EE8E921D5D07ULL, 0x3AFF322E62439FD0ULL}, {0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C3ULL},
+    {0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B4ULL}, {0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A11ULL},
+    {0xB424DC35095CD80FULL, 0x538484C19EF38C95ULL}, {0xE12E13424BB40E13ULL, 0x2865A5F206B06FBAULL},
+    {0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D4ULL}, {0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D749ULL},
+    {0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1CULL}, {0x89705F4136B4A597ULL, 0x31680A88F8953031ULL},
+    {0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3EULL}, {0xD6BF94D5E57A42BCULL, 0x3D32907604691B4DULL},
+    {0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B110ULL}, {0xA7C5AC471B478423ULL, 0x0FCF80DC33721D54ULL},
+    {0xD1B71758E219652BULL, 0xD3C36113404EA4A9ULL}, {0x83126E978D4FDF3BULL, 0x645A1CAC083126EAULL},
+    {0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A4ULL}, {0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCDULL},
+    {0x8000000000000000ULL, 0x0000000000000000ULL}, {0xA000000000000000ULL, 0x0000000000000000ULL},
+    {0xC800000000000000ULL, 0x0000000000000000ULL}, {0xFA00000000000000ULL, 0x0000000000000000ULL},
+    {0x9C40000000000000ULL, 0x0000000000000000ULL}, {0xC350000000000000ULL, 0x0000000000000000ULL},
+    {0xF424000000000000ULL, 0x0000000000000000ULL}, {0x9896800000000000ULL, 0x0000000000000000ULL},
+    {0xBEBC200000000000ULL, 0x0000000000000000ULL}, {0xEE6B280000000000ULL, 0x0000000000000000ULL},
+    {0x9502F90000000000ULL, 0x0000000000000000ULL}, {0xBA43B74000000000ULL, 0x0000000000000000ULL},
+    {0xE8D4A51000000000ULL, 0x0000000000000000ULL}, {0x9184E72A00000000ULL, 0x0000000000000000ULL},
+    {0xB5E620F480000000ULL, 0x0000000000000000ULL}, {0xE35FA931A0000000ULL, 0x0000000000000000ULL},
+    {0x8E1BC9BF04000000ULL, 0x0000000000000000ULL}, {0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL},
+    {0xDE0B6B3A76400000ULL, 0x0000000000000000ULL}, {0x8AC7230489E80000ULL, 0x0000000000000000ULL},
+    {0xAD78EBC5AC620000ULL, 0x0000000000000000ULL}, {0xD8D726B7177A8000ULL, 0x0000000000000000ULL},
+    {0x878678326EAC9000ULL, 0x0000000000000000ULL}, {0xA968163F0A57B400ULL, 0x0000000000000000ULL},
+    {0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL}, {0x84595161401484A0ULL, 0x0000000000000000ULL},
+    {0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL}, {0xCECB8F27F4200F3AULL, 0x0000000000000000ULL},
+    {0x813F3978F8940984ULL, 0x4000000000000000ULL}, {0xA18F07D736B90BE5ULL, 0x5000000000000000ULL},
+    {0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL}, {0xFC6F7C4045812296ULL, 0x4D00000000000000ULL},
+    {0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL}, {0xC5371912364CE305ULL, 0x6C28000000000000ULL},
+    {0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL}, {0x9A130B963A6C115CULL, 0x3C7F400000000000ULL},
+    {0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL}, {0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL},
+    {0x96769950B50D88F4ULL, 0x1314448000000000ULL}, {0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL},
+    {0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL}, {0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL},
+    {0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL}, {0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL},
+    {0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL}, {0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL},
+    {0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL}, {0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL},
+    {0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL}, {0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL},
+    {0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL}, {0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL},
+    {0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL}, {0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL},
+    {0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL}, {0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL},
+    {0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL}, {0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL},
+    {0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL}, {0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL},
+    {0x9F4F2726179A2245ULL, 0x01D762422C946590ULL}, {0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL},
+    {0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL}, {0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL},
+    {0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL}, {0xF316271C7FC3908AULL, 0x8BEF464E3945EF7AULL},
+    {0x97EDD871CFDA3A56ULL, 0x97758BF0E3CBB5ACULL}, {0xBDE94E8E43D0C8ECULL, 0x3D52EEED1CBEA317ULL},
+    {0xED63A231D4C4FB27ULL, 0x4CA7AAA863EE4BDDULL}, {0x945E455F24FB1CF8ULL, 0x8FE8CAA93E74EF6AULL},
+    {0xB975D6B6EE39E436ULL, 0xB3E2FD538E122B44ULL}, {0xE7D34C64A9C85D44ULL, 0x60DBBCA87196B616ULL},
+    {0x90E40FBEEA1D3A4AULL, 0xBC8955E946FE31CDULL}, {0xB51D13AEA4A488DDULL, 0x6BABAB6398BDBE41ULL},
+    {0xE264589A4DCDAB14ULL, 0xC696963C7EED2DD1ULL}, {0x8D7EB76070A08AECULL, 0xFC1E1DE5CF543CA2ULL},
+    {0xB0DE65388CC8ADA8ULL, 0x3B25A55F43294BCBULL}, {0xDD15FE86AFFAD912ULL, 0x49EF0EB713F39EBEULL},
+    {0x8A2DBF142DFCC7ABULL, 0x6E3569326C784337ULL}, {0xACB92ED9397BF996ULL, 0x49C2C37F07965404ULL},
+    {0xD7E77A8F87DAF7FBULL, 0xDC33745EC97BE906ULL}, {0x86F0AC99B4E8DAFDULL, 0x69A028BB3DED71A3ULL},
+    {0xA8ACD7C0222311BCULL, 0xC40832EA0D68CE0CULL}, {0xD2D80DB02AABD62BULL, 0xF50A3FA490C30190ULL},
+    {0x83C7088E1AAB65DBULL, 0x792667C6DA79E0FAULL}, {0xA4B8CAB1A1563F52ULL, 0x577001B891185938ULL},
+    {0xCDE6FD5E09ABCF26ULL, 0xED4C0226B55E6F86ULL}, {0x80B05E5AC60B6178ULL, 0x544F8158315B05B4ULL},
+    {0xA0DC75F1778E39D6ULL, 0x696361AE3DB1C721ULL}, {0xC913936DD571C84CULL, 0x03BC3A19CD1E38E9ULL},
+    {0xFB5878494ACE3A5FULL, 0x04AB48A04065C723ULL}, {0x9D174B2DCEC0E47BULL, 0x62EB0D64283F9C76ULL},
+    {0xC45D1DF942711D9AULL, 0x3BA5D0BD324F8394ULL}, {0xF5746577930D6500ULL, 0xCA8F44EC7EE36479ULL},
+    {0x9968BF6ABBE85F20ULL, 0x7E998B13CF4E1ECBULL}, {0xBFC2EF456AE276E8ULL, 0x9E3FEDD8C321A67EULL},
+    {0xEFB3AB16C59B14A2ULL, 0xC5CFE94EF3EA101EULL}, {0x95D04AEE3B80ECE5ULL, 0xBBA1F1D158724A12ULL},
+    {0xBB445DA9CA61281FULL, 0x2A8A6E45AE8EDC97ULL}, {0xEA1575143CF97226ULL, 0xF52D09D71A3293BDULL},
+    {0x924D692CA61BE758ULL, 0x593C2626705F9C56ULL}, {0xB6E0C377CFA2E12EULL, 0x6F8B2FB00C77836CULL},
+    {0xE498F455C38B997AULL, 0x0B6DFB9C0F956447ULL}, {0x8EDF98B59A373FECULL, 0x4724BD4189BD5EACULL},
+    {0xB2977EE300C50FE7ULL, 0x58EDEC91EC2CB657ULL}, {0xDF3D5E9BC0F653E1ULL, 0x2F2967B66737E3EDULL},
+    {0x8B865B215899F46CULL, 0xBD79E0D20082EE74ULL}, {0xAE67F1E9AEC07187ULL, 0xECD8590680A3AA11ULL},
+    {0xDA01EE641A708DE9ULL, 0xE80E6F4820CC9495ULL}, {0x884134FE908658B2ULL, 0x3109058D147FDCDDULL},
+    {0xAA51823E34A7EEDEULL, 0xBD4B46F0599FD415ULL}, {0xD4E5E2CDC1D1EA96ULL, 0x6C9E18AC7007C91AULL},
+    {0x850FADC09923329EULL, 0x03E2CF6BC604DDB0ULL}, {0xA6539930BF6BFF45ULL, 0x84DB8346B786151CULL},
+    {0xCFE87F7CEF46FF16ULL, 0xE612641865679A63ULL}, {0x81F14FAE158C5F6EULL, 0x4FCB7E8F3F60C07EULL},
+    {0xA26DA3999AEF7749ULL, 0xE3BE5E330F38F09DULL}, {0xCB090C8001AB551CULL, 0x5CADF5BFD3072CC5ULL},
+    {0xFDCB4FA002162A63ULL, 0x73D9732FC7C8F7F6ULL}, {0x9E9F11C4014DDA7EULL, 0x2867E7FDDCDD9AFAULL},
+    {0xC646D63501A1511DULL, 0xB281E1FD541501B8ULL}, {0xF7D88BC24209A565ULL, 0x1F225A7CA91A4226ULL},
+    {0x9AE757596946075FULL, 0x3375788DE9B06958ULL}, {0xC1A12D2FC3978937ULL, 0x0052D6B1641C83AEULL},
+    {0xF209787BB47D6B84ULL, 0xC0678C5DBD23A49AULL}, {0x9745EB4D50CE6332ULL, 0xF840B7BA963646E0ULL},
+    {0xBD176620A501FBFFULL, 0xB650E5A93BC3D898ULL}, {0xEC5D3FA8CE427AFFULL, 0xA3E51F138AB4CEBEULL},
+    {0x93BA47C980E98CDFULL, 0xC66F336C36B10137ULL}, {0xB8A8D9BBE123F017ULL, 0xB80B0047445D4184ULL},
+    {0xE6D3102AD96CEC1DULL, 0xA60DC059157491E5ULL}, {0x9043EA1AC7E41392ULL, 0x87C89837AD68DB2FULL},
+    {0xB454E4A179DD1877ULL, 0x29BABE4598C311FBULL}, {0xE16A1DC9D8545E94ULL, 0xF4296DD6FEF3D67AULL},
+    {0x8CE2529E2734BB1DULL, 0x1899E4A65F58660CULL}, {0xB01AE745B101E9E4ULL, 0x5EC05DCFF72E7F8FULL},
+    {0xDC21A1171D42645DULL, 0x76707543F4FA1F73ULL}, {0x899504AE72497EBAULL, 0x6A06494A791C53A8ULL},
+    {0xABFA45DA0EDBDE69ULL, 0x0487DB9D17636892ULL}, {0xD6F8D7509292D603ULL, 0x45A9D2845D3C42B6ULL},
+    {0x865B86925B9BC5C2ULL, 0x0B8A2392BA45A9B2ULL}, {0xA7F26836F282B732ULL, 0x8E6CAC7768D7141EULL},
+    {0xD1EF0244AF2364FFULL, 0x3207D795430CD926ULL}, {0x8335616AED761F1FULL, 0x7F44E6BD49E807B8ULL},
+    {0xA402B9C5A8D3A6E7ULL, 0x5F16206C9C6209A6ULL}, {0xCD036837130890A1ULL, 0x36DBA887C37A8C0FULL},
+    {0x802221226BE55A64ULL, 0xC2494954DA2C9789ULL}, {0xA02AA96B06DEB0FDULL, 0xF2DB9BAA10B7BD6CULL},
+    {0xC83553C5C8965D3DULL, 0x6F92829494E5ACC7ULL}, {0xFA42A8B73ABBF48CULL, 0xCB772339BA1F17F9ULL},
+    {0x9C69A97284B578D7ULL, 0xFF2A760414536EFBULL}, {0xC38413CF25E2D70DULL, 0xFEF5138519684ABAULL},
+    {0xF46518C2EF5B8CD1ULL, 0x7EB258665FC25D69ULL}, {0x98BF2F79D5993802ULL, 0xEF2F773FFBD97A61ULL},
+    {0xBEEEFB584AFF8603ULL, 0xAAFB550FFACFD8FAULL}, {0xEEAABA2E5DBF6784ULL, 0x95BA2A53F983CF38ULL},
+    {0x952AB45CFA97A0B2ULL, 0xDD945A747BF26183ULL}, {0xBA756174393D88DFULL, 0x94F971119AEEF9E4ULL},
+    {0xE912B9D1478CEB17ULL, 0x7A37CD5601AAB85DULL}, {0x91ABB422CCB812EEULL, 0xAC62E055C10AB33AULL},
+    {0xB616A12B7FE617AAULL, 0x577B986B314D6009ULL}, {0xE39C49765FDF9D94ULL, 0xED5A7E85FDA0B80BULL},
+    {0x8E41ADE9FBEBC27DULL, 0x14588F13BE847307ULL}, {0xB1D219647AE6B31CULL, 0x596EB2D8AE258FC8ULL},
+    {0xDE469FBD99A05FE3ULL, 0x6FCA5F8ED9AEF3BBULL}, {0x8AEC23D680043BEEULL, 0x25DE7BB9480D5854ULL},
+    {0xADA72CCC20054AE9ULL, 0xAF561AA79A10AE6AULL}, {0xD910F7FF28069DA4ULL, 0x1B2BA1518094DA04ULL},
+    {0x87AA9AFF79042286ULL, 0x90FB44D2F05D0842ULL}, {0xA99541BF57452B28ULL, 0x353A1607AC744A53ULL},
+    {0xD3FA922F2D1675F2ULL, 0x42889B8997915CE8ULL}, {0x847C9B5D7C2E09B7ULL, 0x69956135FEBADA11ULL},
+    {0xA59BC234DB398C25ULL, 0x43FAB9837E699095ULL}, {0xCF02B2C21207EF2EULL, 0x94F967E45E03F4BBULL},
+    {0x8161AFB94B44F57DULL, 0x1D1BE0EEBAC278F5ULL}, {0xA1BA1BA79E1632DCULL, 0x6462D92A69731732ULL},
+    {0xCA28A291859BBF93ULL, 0x7D7B8F7503CFDCFEULL}, {0xFCB2CB35E702AF78ULL, 0x5CDA735244C3D43EULL},
+    {0x9DEFBF01B061ADABULL, 0x3A0888136AFA64A7ULL}, {0xC56BAEC21C7A1916ULL, 0x088AAA1845B8FDD0ULL},
+    {0xF6C69A72A3989F5BULL, 0x8AAD549E57273D45ULL}, {0x9A3C2087A63F6399ULL, 0x36AC54E2F678864BULL},
+    {0xC0CB28A98FCF3C7FULL, 0x84576A1BB416A7DDULL}, {0xF0FDF2D3F3C30B9FULL, 0x656D44A2A11C51D5ULL},
+    {0x969EB7C47859E743ULL, 0x9F644AE5A4B1B325ULL}, {0xBC4665B596706114ULL, 0x873D5D9F0DDE1FEEULL},
+    {0xEB57FF22FC0C7959ULL, 0xA90CB506D155A7EAULL}, {0x9316FF75DD87CBD8ULL, 0x09A7F12442D588F2ULL},
+    {0xB7DCBF5354E9BECEULL, 0x0C11ED6D538AEB2FULL}, {0xE5D3EF282A242E81ULL, 0x8F1668C8A86DA5FAULL},
+    {0x8FA475791A569D10ULL, 0xF96E017D694487BCULL}, {0xB38D92D760EC4455ULL, 0x37C981DCC395A9ACULL},
+    {0xE070F78D3927556AULL, 0x85BBE253F47B1417ULL}, {0x8C469AB843B89562ULL, 0x93956D7478CCEC8EULL},
+    {0xAF58416654A6BABBULL, 0x387AC8D1970027B2ULL}, {0xDB2E51BFE9D0696AULL, 0x06997B05FCC0319EULL},
+    {0x88FCF317F22241E2ULL, 0x441FECE3BDF81F03ULL}, {0xAB3C2FDDEEAAD25AULL, 0xD527E81CAD7626C3ULL},
+    {0xD60B3BD56A5586F1ULL, 0x8A71E223D8D3B074ULL}, {0x85C7056562757456ULL, 0xF6872D5667844E49ULL},
+    {0xA738C6BEBB12D16CULL, 0xB428F8AC016561DBULL}, {0xD106F86E69D785C7ULL, 0xE13336D701BEBA52ULL},
+    {0x82A45B450226B39CULL, 0xECC0024661173473ULL}, {0xA34D721642B06084ULL, 0x27F002D7F95D0190ULL},
+    {0xCC20CE9BD35C78A5ULL, 0x31EC038DF7B441F4ULL}, {0xFF290242C83396CEULL, 0x7E67047175A15271ULL},
+    {0x9F79A169BD203E41ULL, 0x0F0062C6E984D386ULL}, {0xC75809C42C684DD1ULL, 0x52C07B78A3E60868ULL},
+    {0xF92E0C3537826145ULL, 0xA7709A56CCDF8A82ULL}, {0x9BBCC7A142B17CCBULL, 0x88A66076400BB691ULL},
+    {0xC2ABF989935DDBFEULL, 0x6ACFF893D00EA435ULL}, {0xF356F7EBF83552FEULL, 0x0583F6B8C4124D43ULL},
+    {0x98165AF37B2153DEULL, 0xC3727A337A8B704AULL}, {0xBE1BF1B059E9A8D6ULL, 0x744F18C0592E4C5CULL},
+    {0xEDA2EE1C7064130CULL, 0x1162DEF06F79DF73ULL}, {0x9485D4D1C63E8BE7ULL, 0x8ADDCB5645AC2BA8ULL},
+    {0xB9A74A0637CE2EE1ULL, 0x6D953E2BD7173692ULL}, {0xE8111C87C5C1BA99ULL, 0xC8FA8DB6CCDD0437ULL},
+    {0x910AB1D4DB9914A0ULL, 0x1D9C9892400A22A2ULL}, {0xB54D5E4A127F59C8ULL, 0x2503BEB6D00CAB4BULL},
+    {0xE2A0B5DC971F303AULL, 0x2E44AE64840FD61DULL}, {0x8DA471A9DE737E24ULL, 0x5CEAECFED289E5D2ULL},
+    {0xB10D8E1456105DADULL, 0x7425A83E872C5F47ULL}, {0xDD50F1996B947518ULL, 0xD12F124E28F77719ULL},
+    {0x8A5296FFE33CC92FULL, 0x82BD6B70D99AAA6FULL}, {0xACE73CBFDC0BFB7BULL, 0x636CC64D1001550BULL},
+    {0xD8210BEFD30EFA5AULL, 0x3C47F7E05401AA4EULL}, {0x8714A775E3E95C78ULL, 0x65ACFAEC34810A71ULL},
+    {0xA8D9D1535CE3B396ULL, 0x7F1839A741A14D0DULL}, {0xD31045A8341CA07CULL, 0x1EDE48111209A050ULL},
+    {0x83EA2B892091E44DULL, 0x934AED0AAB460432ULL}, {0xA4E4B66B68B65D60ULL, 0xF81DA84D5617853FULL},
+    {0xCE1DE40642E3F4B9ULL, 0x36251260AB9D668EULL}, {0x80D2AE83E9CE78F3ULL, 0xC1D72B7C6B426019ULL},
+    {0xA1075A24E4421730ULL, 0xB24CF65B8612F81FULL}, {0xC94930AE1D529CFCULL, 0xDEE033F26797B627ULL},
+    {0xFB9B7CD9A4A7443CULL, 0x169840EF017DA3B1ULL}, {0x9D412E0806E88AA5ULL, 0x8E1F289560EE864EULL},
+    {0xC491798A08A2AD4EULL, 0xF1A6F2BAB92A27E2ULL}, {0xF5B5D7EC8ACB58A2ULL, 0xAE10AF696774B1DBULL},
+    {0x9991A6F3D6BF1765ULL, 0xACCA6DA1E0A8EF29ULL}, {0xBFF610B0CC6EDD3FULL, 0x17FD090A58D32AF3ULL},
+    {0xEFF394DCFF8A948EULL, 0xDDFC4B4CEF07F5B0ULL}, {0x95F83D0A1FB69CD9ULL, 0x4ABDAF101564F98EULL},
+    {0xBB764C4CA7A4440FULL, 0x9D6D1AD41ABE37F1ULL}, {0xEA53DF5FD18D5513ULL, 0x84C86189216DC5EDULL},
+    {0x92746B9BE2F8552CULL, 0x32FD3CF5B4E49BB4ULL}, {0xB7118682DBB66A77ULL, 0x3FBC8C33221DC2A1ULL},
+    {0xE4D5E82392A40515ULL, 0x0FABAF3FEAA5334AULL}, {0x8F05B1163BA6832DULL, 0x29CB4D87F2A7400EULL},
+    {0xB2C71D5BCA9023F8ULL, 0x743E20E9EF511012ULL}, {0xDF78E4B2BD342CF6ULL, 0x914DA9246B255416ULL},
+    {0x8BAB8EEFB6409C1AULL, 0x1AD089B6C2F7548EULL}, {0xAE9672ABA3D0C320ULL, 0xA184AC2473B529B1ULL},
+    {0xDA3C0F568CC4F3E8ULL, 0xC9E5D72D90A2741EULL}, {0x8865899617FB1871ULL, 0x7E2FA67C7A658892ULL},
+    {0xAA7EEBFB9DF9DE8DULL, 0xDDBB901B98FEEAB7ULL}, {0xD51EA6FA85785631ULL, 0x552A74227F3EA565ULL},
+    {0x8533285C936B35DEULL, 0xD53A88958F87275FULL}, {0xA67FF273B8460356ULL, 0x8A892ABAF368F137ULL},
+    {0xD01FEF10A657842CULL, 0x2D2B7569B0432D85ULL}, {0x8213F56A67F6B29BULL, 0x9C3B29620E29FC73ULL},
+    {0xA298F2C501F45F42ULL, 0x8349F3BA91B47B8FULL}, {0xCB3F2F7642717713ULL, 0x241C70A936219A73ULL},
+    {0xFE0EFB53D30DD4D7ULL, 0xED238CD383AA0110ULL}, {0x9EC95D1463E8A506ULL, 0xF4363804324A40AAULL},
+    {0xC67BB4597CE2CE48ULL, 0xB143C6053EDCD0D5ULL}, {0xF81AA16FDC1B81DAULL, 0xDD94B7868E94050AULL},
+    {0x9B10A4E5E9913128ULL, 0xCA7CF2B4191C8326ULL}, {0xC1D4CE1F63F57D72ULL, 0xFD1C2F611F63A3F0ULL},
+    {0xF24A01A73CF2DCCFULL, 0xBC633B39673C8CECULL}, {0x976E41088617CA01ULL, 0xD5BE0503E085D813ULL},
+    {0xBD49D14AA79DBC82ULL, 0x4B2D8644D8A74E18ULL}, {0xEC9C459D51852BA2ULL, 0xDDF8E7D60ED1219EULL},
+    {0x93E1AB8252F33B45ULL, 0xCABB90E5C942B503ULL}, {0xB8DA1662E7B00A17ULL, 0x3D6A751F3B936243ULL},
+    {0xE7109BFBA19C0C9DULL, 0x0CC512670A783AD4ULL}, {0x906A617D450187E2ULL, 0x27FB2B80668B24C5ULL},
+    {0xB484F9DC9641E9DAULL, 0xB1F9F660802DEDF6ULL}, {0xE1A63853BBD26451ULL, 0x5E7873F8A0396973ULL},
+    {0x8D07E33455637EB2ULL, 0xDB0B487B6423E1E8ULL}, {0xB049DC016ABC5E5FULL, 0x91CE1A9A3D2CDA62ULL},
+    {0xDC5C5301C56B75F7ULL, 0x7641A140CC7810FBULL}, {0x89B9B3E11B6329BAULL, 0xA9E904C87FCB0A9DULL},
+    {0xAC2820D9623BF429ULL, 0x546345FA9FBDCD44ULL}, {0xD732290FBACAF133ULL, 0xA97C177947AD4095ULL},
+    {0x867F59A9D4BED6C0ULL, 0x49ED8EABCCCC485DULL}, {0xA81F301449EE8C70ULL, 0x5C68F256BFFF5A74ULL},
+    {0xD226FC195C6A2F8CULL, 0x73832EEC6FFF3111ULL}, {0x83585D8FD9C25DB7ULL, 0xC831FD53C5FF7EABULL},
+    {0xA42E74F3D032F525ULL, 0xBA3E7CA8B77F5E55ULL}, {0xCD3A1230C43FB26FULL, 0x28CE1BD2E55F35EBULL},
+    {0x80444B5E7AA7CF85ULL, 0x7980D163CF5B81B3ULL}, {0xA0555E361951C366ULL, 0xD7E105BCC332621FULL},
+    {0xC86AB5C39FA63440ULL, 0x8DD9472BF3FEFAA7ULL}, {0xFA856334878FC150ULL, 0xB14F98F6F0FEB951ULL},
+    {0x9C935E00D4B9D8D2ULL, 0x6ED1BF9A569F33D3ULL}, {0xC3B8358109E84F07ULL, 0x0A862F80EC4700C8ULL},
+    {0xF4A642E14C6262C8ULL, 0xCD27BB612758C0FAULL}, {0x98E7E9CCCFBD7DBDULL, 0x8038D51CB897789CULL},
+    {0xBF21E44003ACDD2CULL, 0xE0470A63E6BD56C3ULL}, {0xEEEA5D5004981478ULL, 0x1858CCFCE06CAC74ULL},
+    {0x95527A5202DF0CCBULL, 0x0F37801E0C43EBC8ULL}, {0xBAA718E68396CFFDULL, 0xD30560258F54E6BAULL},
+    {0xE950DF20247C83FDULL, 0x47C6B82EF32A2069ULL}, {0x91D28B7416CDD27EULL, 0x4CDC331D57FA5441ULL},
+    {0xB6472E511C81471DULL, 0xE0133FE4ADF8E952ULL}, {0xE3D8F9E563A198E5ULL, 0x58180FDDD97723A6ULL},
+    {0x8E679C2F5E44FF8FULL, 0x570F09EAA7EA7648ULL}, {0xB201833B35D63F73ULL, 0x2CD2CC6551E513DAULL},
+    {0xDE81E40A034BCF4FULL, 0xF8077F7EA65E58D1ULL}, {0x8B112E86420F6191ULL, 0xFB04AFAF27FAF782ULL},
+    {0xADD57A27D29339F6ULL, 0x79C5DB9AF1F9B563ULL}, {0xD94AD8B1C7380874ULL, 0x18375281AE7822BCULL},
+    {0x87CEC76F1C830548ULL, 0x8F2293910D0B15B5ULL}, {0xA9C2794AE3A3C69AULL, 0xB2EB3875504DDB22ULL},
+    {0xD433179D9C8CB841ULL, 0x5FA60692A46151EBULL}, {0x849FEEC281D7F328ULL, 0xDBC7C41BA6BCD333ULL},
+    {0xA5C7EA73224DEFF3ULL, 0x12B9B522906C0800ULL}, {0xCF39E50FEAE16BEFULL, 0xD768226B34870A00ULL},
+    {0x81842F29F2CCE375ULL, 0xE6A1158300D46640ULL}, {0xA1E53AF46F801C53ULL, 0x60495AE3C1097FD0ULL},
+    {0xCA5E89B18B602368ULL, 0x385BB19CB14BDFC4ULL}, {0xFCF62C1DEE382C42ULL, 0x46729E03DD9ED7B5ULL},
+    {0x9E19DB92B4E31BA9ULL, 0x6C07A2C26A8346D1ULL},
+};
+
+#define CSV__F64_INFINITY 0x7FF0000000000000ULL
+
+// Eisel-Lemire: the bits of the double nearest to w*10^q, for any w != 0 of up to 19 digits. The top 64 bits of
+// w*5^q are almost always enough to round; the next 64 only when the bits below the 55 we keep are all ones.
+static uint64_t csv__eisel_lemire(uint64_t w, int64_t q) {
+    if (q < CSV__POW5_MIN) return 0;
+    if (q > 308) return CSV__F64_INFINITY;
+    unsigned lz = csv__clz64(w);
+    w <<= lz;
+    const uint64_t *power = csv__powers_of_five[q - CSV__POW5_MIN];
+    uint64_t high;
+    uint64_t low = csv__mul128(w, power[0], &high);
+    if ((high & 0x1FF) == 0x1FF) {
+        uint64_t next;
+        csv__mul128(w, power[1], &next);
+        low += next;
+        if (next > low) high += 1;
+    }
+    unsigned upper = (unsigned)(high >> 63);
+    uint64_t mantissa = high >> (upper + 9);
+    // floor(log2(10^q)) + 63 is where the top bit of w*10^q sits, then the bias
+    int64_t power2 = (((152170 + 65536)*q) >> 16) + 63 + upper - lz + 1023;
+
+    if (power2 <= 0) {
+        // Subnormal, or zero. A carry out of the mantissa lands in the exponent bits and makes the smallest normal.
+        if (-power2 + 1 >= 64) return 0;
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        return mantissa >> 1;
+    }
+    // Exactly halfway between two doubles is only possible for small q: round to even there instead of up
+    if (low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << (upper + 9)) == high) {
+        mantissa &= ~(uint64_t)1;
+    }
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= (uint64_t)2 << 52) {
+        mantissa = (uint64_t)1 << 52;
+        power2 += 1;
+    }
+    if (power2 >= 0x7FF) return CSV__F64_INFINITY;
+    return (mantissa & (((uint64_t)1 << 52) - 1)) | (uint64_t)power2 << 52;
+}
+
+Csv_Parse_Result csv_parse_f64(Csv_String_View sv, double *out) {
+    const double *powers = csv__exact_powers;
+
+    const char *p = csv_sv_data(sv);
+    const char *end = p + csv_sv_count(sv);
+    while (p < end && csv__is_blank(*p)) p += 1;
+    while (end > p && csv__is_blank(end[-1])) end -= 1;
+    const char *start = p;
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p += 1;
+    }
+    // inf and nan are rare enough to leave to strtod()
+    if (p < end && !csv__is_digit(*p) && *p != '.') return csv__parse_f64_slow(start, end, out);
+
+    uint64_t mantissa = 0;
+    size_t digits = 0;
+    size_t dropped = 0;
+    int64_t exponent = 0;
+
+    const char *integer = p;
+    while (p < end && *p == '0') p += 1;
+    csv__read_digits(&p, end, &mantissa, &digits, &dropped);
+    size_t read = p - integer;
+    exponent += dropped;
+
+    if (p < end && *p == '.') {
+        p += 1;
+        const char *fraction = p;
+        if (mantissa == 0) {
+            while (p < end && *p == '0') p += 1;
+        }
+        size_t leading_zeros = p - fraction;
+        size_t before = dropped;
+        size_t fraction_read = csv__read_digits(&p, end, &mantissa, &digits, &dropped);
+        exponent -= (int64_t)(leading_zeros + fraction_read - (dropped - before));
+        read += leading_zeros + fraction_read;
+    }
+    if (read == 0) return CSV_PARSE_INVALID;
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p += 1;
+        bool exponent_negative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            exponent_negative = *p == '-';
+            p += 1;
+        }
+        if (p == end || !csv__is_digit(*p)) return CSV_PARSE_INVALID;
+        int64_t e = 0;
+        while (p < end && csv__is_digit(*p)) {
+            // Way past the range of a double either way, stop growing so it can't overflow
+            if (e < 100000) e = e*10 + (*p - '0');
+            p += 1;
+        }
+        exponent += exponent_negative ? -e : e;
+    }
+    if (p != end) return CSV_PARSE_INVALID;
+
+    // Clinger's fast path: both the mantissa and the power of ten are exact doubles,
+    // so one correctly rounded multiplication or division gives the correctly rounded result
+    const uint64_t max_exact = (uint64_t)1 << 53;
+    if (dropped == 0 && mantissa <= max_exact) {
+        double value = (double)mantissa;
+        bool exact = true;
+        if (mantissa == 0) {
+            value = 0;
+        } else if (exponent >= 0 && exponent <= 22) {
+            value *= powers[exponent];
+        } else if (exponent < 0 && exponent >= -22) {
+            value /= powers[-exponent];
+        } else if (exponent > 22 && exponent <= 22 + 15) {
+            // Move the extra zeros into the mantissa if it stays exact
+            uint64_t scaled = mantissa;
+            for (int64_t i = 22; i < exponent && scaled <= max_exact; i++) scaled *= 10;
+            exact = scaled <= max_exact;
+            value = (double)scaled*powers[22];
+        } else {
+            exact = false;
+        }
+        if (exact) {
+            *out = negative ? -value : value;
+            return CSV_PARSE_OK;
+        }
+    }
+
+    // Past 19 digits the mantissa was cut short, so the number is somewhere in [mantissa, mantissa + 1)*10^exponent.
+    // Both ends rounding to the same double settles it.
+    uint64_t bits = csv__eisel_lemire(mantissa, exponent);
+    if (dropped == 0 || csv__eisel_lemire(mantissa + 1, exponent) == bits) {
+        if (bits == CSV__F64_INFINITY) return CSV_PARSE_OVERFLOW;
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        *out = negative ? -value : value;
+        return CSV_PARSE_OK;
+    }
+    return csv__parse_f64_slow(start, end, out);
+}
+
+void csv_batch_init(Csv_Batch *batch, const Csv_Column_Type *types, const size_t *sources, size_t columns_count, size_t capacity) {
+    memset(batch, 0, sizeof(*batch));
+    batch->capacity = capacity;
+    batch->columns_count = columns_count;
+    batch->columns = CSV_REALLOC(NULL, columns_count*sizeof(*batch->columns));
+    assert(batch->columns != NULL && "Buy more RAM lol");
+
+    for (size_t i = 0; i < columns_count; i++) {
+        if (sources[i] + 1 > batch->sources) batch->sources = sources[i] + 1;
+    }
+    batch->by_source = CSV_REALLOC(NULL, (batch->sources > 0 ? batch->sources : 1)*sizeof(*batch->by_source));
+    assert(batch->by_source != NULL && "Buy more RAM lol");
+    for (size_t i = 0; i < batch->sources; i++) batch->by_source[i] = -1;
+
+    for (size_t i = 0; i < columns_count; i++) {
+        Csv_Column *column = &batch->columns[i];
+        memset(column, 0, sizeof(*column));
+        column->type = types[i];
+        column->source = sources[i];
+        assert(batch->by_source[sources[i]] == -1 && "Two columns from the same item");
+        batch->by_source[sources[i]] = (int)i;
+    }
+}
+
+// Allocates whatever buffers the column is missing, either because it's new or because they were exported
+static void csv__column_alloc(Csv_Column *column, size_t capacity) {
+    switch (column->type) {
+    case CSV_COLUMN_I64:
+        if (column->i64 == NULL) column->i64 = CSV_REALLOC(NULL, capacity*sizeof(*column->i64));
+        assert(column->i64 != NULL && "Buy more RAM lol");
+        break;
+    case CSV_COLUMN_F64:
+        if (column->f64 == NULL) column->f64 = CSV_REALLOC(NULL, capacity*sizeof(*column->f64));
+        assert(column->f64 != NULL && "Buy more RAM lol");
+        break;
+    case CSV_COLUMN_STRING:
+        if (column->offsets == NULL) column->offsets = CSV_REALLOC(NULL, (capacity + 1)*sizeof(*column->offsets));
+        assert(column->offsets != NULL && "Buy more RAM lol");
+        break;
+    case CSV_COLUMN_STRING_VIEW:
+        if (column->views == NULL) column->views = CSV_REALLOC(NULL, capacity*sizeof(*column->views));
+        assert(column->views != NULL && "Buy more RAM lol");
+        break;
+    default:
+        assert(0 && "unreachable");
+    }
+    if (column->validity == NULL) column->validity = CSV_REALLOC(NULL, (capacity + 7)/8 + 1);
+    assert(column->validity != NULL && "Buy more RAM lol");
+}
+
+// Makes room for `count` more bytes in the column's own buffer
+static void csv__column_reserve(Csv_Column *column, size_t count) {
+    if (column->bytes_count + count > column->bytes_capacity) {
+        size_t capacity = column->bytes_capacity == 0 ? CSV__DA_INIT_CAP : column->bytes_capacity;
+        while (column->bytes_count + count > capacity) capacity *= 2;
+        column->bytes = CSV_REALLOC(column->bytes, capacity);
+        assert(column->bytes != NULL && "Buy more RAM lol");
+        column->bytes_capacity = capacity;
+    }
+}
+
+static void csv__column_set(Csv_Column *column, size_t row, Csv_Item item, Csv_Config config) {
+    bool valid = true;
+    const char *data = csv_sv_data(item.view);
+    size_t count = csv_sv_count(item.view);
+    switch (column->type) {
+    case CSV_COLUMN_I64:
+        valid = csv_parse_i64(item.view, &column->i64[row]) == CSV_PARSE_OK;
+        break;
+    case CSV_COLUMN_F64:
+        valid = csv_parse_f64(item.view, &column->f64[row]) == CSV_PARSE_OK;
+        break;
+    case CSV_COLUMN_STRING: {
+        // The previous row left offsets[row] == bytes_count, so appending is all it takes
+        csv__column_reserve(column, count);
+        if (item.escaped) {
+            column->bytes_count += csv__unescape_to(column->bytes + column->bytes_count, data, count, config);
+        } else if (count > 0) {
+            memcpy(column->bytes + column->bytes_count, data, count);
+            column->bytes_count += count;
+        }
+        column->offsets[row + 1] = column->bytes_count;
+    } break;
+    case CSV_COLUMN_STRING_VIEW: {
+        // Clean items point into the parsed buffer (buffer 0), escaped ones are unescaped into the column's bytes (buffer 1)
+        int32_t buffer = 0;
+        size_t offset = data - column->base;
+        if (item.escaped) {
+            csv__column_reserve(column, count);
+            offset = column->bytes_count;
+            data = column->bytes + offset;
+            count = csv__unescape_to(column->bytes + offset, csv_sv_data(item.view), count, config);
+            column->bytes_count += count;
+            buffer = 1;
+        }
+
+        Csv_View *view = &column->views[row];
+        assert(count <= INT32_MAX && "String too long for an Arrow string_view");
+        view->inlined.length = (int32_t)count;
+        if (count <= sizeof(view->inlined.data)) {
+            memcpy(view->inlined.data, data, count);
         } else {
+            assert(offset <= INT32_MAX && "Batch too big for an Arrow string_view, use fewer rows per batch");
+            memcpy(view->ref.prefix, data, sizeof(view->ref.prefix));
+            view->ref.buffer = buffer;
+            view->ref.offset = (int32_t)offset;
+        }
+    } break;
+    default:
+        assert(0 && "unreachable");
+    }
+    if (valid) {
+        column->validity[row/8] |= 1 << row%8;
+        column->null_count -= 1;
+    }
+}
+
+size_t csv_batch_read(Csv_Batch *batch, Csv_String_View *file, Csv_Config config) {
+    const char *start = csv_sv_data(*file);
+    for (size_t i = 0; i < batch->columns_count; i++) {
+        Csv_Column *column = &batch->columns[i];
+        csv__column_alloc(column, batch->capacity);
+        column->bytes_count = 0;
+        column->null_count = 0;
+        column->base = start;
+        if (column->offsets) column->offsets[0] = 0;
+        memset(column->validity, 0, (batch->capacity + 7)/8 + 1);
+    }
+
+    size_t rows = 0;
+    Csv_String_View row = {0};
+    while (rows < batch->capacity && csv_next_row(file, &row, config)) {
+        // Every column starts the row as a null 0 (or empty string) and is overwritten if its item is there
+        for (size_t i = 0; i < batch->columns_count; i++) {
+            Csv_Column *column = &batch->columns[i];
+            column->null_count += 1;
+            switch (column->type) {
+            case CSV_COLUMN_I64:         column->i64[rows] = 0; break;
+            case CSV_COLUMN_F64:         column->f64[rows] = 0; break;
+            case CSV_COLUMN_STRING:      column->offsets[rows + 1] = column->bytes_count; break;
+            case CSV_COLUMN_STRING_VIEW: memset(&column->views[rows], 0, sizeof(Csv_View)); break;
+            default: assert(0 && "unreachable");
+            }
+        }
+
+        Csv_Item item = {0};
+        for (size_t source = 0; source < batch->sources; source++) {
+            // Items no column wants are skipped all at once
+            size_t unwanted = 0;
+            while (source + unwanted < batch->sources && batch->by_source[source + unwanted] < 0) unwanted += 1;
+            if (unwanted > 0) {
+                csv_skip_items(&row, unwanted, config);
+                source += unwanted;
+                if (source == batch->sources) break;
+            }
+            if (!csv_next_item_ex(&row, &item, config)) break;
+            csv__column_set(&batch->columns[batch->by_source[source]], rows, item, config);
+        }
+        rows += 1;
+    }
+
+    for (size_t i = 0; i < batch->columns_count; i++) {
+        batch->columns[i].base_count = csv_sv_data(*file) - start;
+    }
+    batch->rows = rows;
+    return rows;
+}
+
+void csv_batch_free(Csv_Batch *batch) {
+    for (size_t i = 0; i < batch->columns_count; i++) {
+        Csv_Column *column = &batch->columns[i];
+        CSV_FREE(column->i64);
+        CSV_FREE(column->f64);
+        CSV_FREE(column->offsets);
+        CSV_FREE(column->bytes);
+        CSV_FREE(column->views);
+        CSV_FREE(column->validity);
+    }
+    CSV_FREE(batch->columns);
+    CSV_FREE(batch->by_source);
+    memset(batch, 0, sizeof(*batch));
+}
+
+// Everything an exported ArrowArray owns, freed by its release callback
+typedef struct {
+    const void *buffers[5];
+    void *owned[3];
+    int64_t variadic_sizes[2];
+    struct ArrowArray **children;
+    int64_t n_children;
+} Csv__Arrow_Array;
+
+static void csv__arrow_array_release(struct ArrowArray *array) {
+    Csv__Arrow_Array *private = array->private_data;
+    for (int64_t i = 0; i < private->n_children; i++) {
+        struct ArrowArray *child = private->children[i];
+        if (child->release) child->release(child);
+        CSV_FREE(child);
+    }
+    CSV_FREE(private->children);
+    for (size_t i = 0; i < CSV__ARRAY_LEN(private->owned); i++) CSV_FREE(private->owned[i]);
+    CSV_FREE(private);
+    array->release = NULL;
+}
+
+static void csv__arrow_schema_release(struct ArrowSchema *schema) {
+    for (int64_t i = 0; i < schema->n_children; i++) {
+        struct ArrowSchema *child = schema->children[i];
+        if (child->release) child->release(child);
+        CSV_FREE(child);
+    }
+    CSV_FREE(schema->children);
+    // Children own a copy of their name, the struct itself has none
+    CSV_FREE((char *)schema->name);
+    schema->release = NULL;
+}
+
+static char *csv__strdup(const char *s) {
+    size_t n = strlen(s) + 1;
+    char *copy = CSV_REALLOC(NULL, n);
+    assert(copy != NULL && "Buy more RAM lol");
+    memcpy(copy, s, n);
+    return copy;
+}
+
+static Csv__Arrow_Array *csv__arrow_array_new(struct ArrowArray *array, int64_t length, int64_t null_count, int64_t n_buffers, int64_t n_children) {
+    Csv__Arrow_Array *private = CSV_REALLOC(NULL, sizeof(*private));
+    assert(private != NULL && "Buy more RAM lol");
+    memset(private, 0, sizeof(*private));
+    memset(array, 0, sizeof(*array));
+    array->length = length;
+    array->null_count = null_count;
+    array->n_buffers = n_buffers;
+    array->n_children = n_children;
+    array->buffers = private->buffers;
+    array->release = csv__arrow_array_release;
+    array->private_data = private;
+    return private;
+}
+
+void csv_batch_export_arrow(Csv_Batch *batch, const char *const *names, struct ArrowSchema *schema, struct ArrowArray *array) {
+    int64_t n = (int64_t)batch->columns_count;
+
+    memset(schema, 0, sizeof(*schema));
+    schema->format = "+s";
+    schema->name = NULL;
+    schema->n_children = n;
+    schema->children = CSV_REALLOC(NULL, (n > 0 ? n : 1)*sizeof(*schema->children));
+    schema->release = csv__arrow_schema_release;
+
+    Csv__Arrow_Array *parent = csv__arrow_array_new(array, (int64_t)batch->rows, 0, 1, n);
+    parent->n_children = n;
+    parent->children = CSV_REALLOC(NULL, (n > 0 ? n : 1)*sizeof(*parent->children));
+    array->children = parent->children;
+    assert(schema->children != NULL && parent->children != NULL && "Buy more RAM lol");
+
+    for (int64_t i = 0; i < n; i++) {
+        Csv_Column *column = &batch->columns[i];
+
+        struct ArrowSchema *child_schema = CSV_REALLOC(NULL, sizeof(*child_schema));
+        struct ArrowArray *child = CSV_REALLOC(NULL, sizeof(*child));
+        assert(child_schema != NULL && child != NULL && "Buy more RAM lol");
+        schema->children[i] = child_schema;
+        parent->children[i] = child;
+
+        memset(child_schema, 0, sizeof(*child_schema));
+        child_schema->name = csv__strdup(names[i]);
+        child_schema->flags = ARROW_FLAG_NULLABLE;
+        child_schema->release = csv__arrow_schema_release;
+
+        Csv__Arrow_Array *private = NULL;
+        switch (column->type) {
+        case CSV_COLUMN_I64:
+            child_schema->format = "l";
+            private = csv__arrow_array_new(child, (int64_t)batch->rows, (int64_t)column->null_count, 2, 0);
+            private->buffers[1] = private->owned[1] = column->i64;
+            column->i64 = NULL;
+            break;
+        case CSV_COLUMN_F64:
+            child_schema->format = "g";
+            private = csv__arrow_array_new(child, (int64_t)batch->rows, (int64_t)column->null_count, 2, 0);
+            private->buffers[1] = private->owned[1] = column->f64;
+            column->f64 = NULL;
+            break;
+        case CSV_COLUMN_STRING:
+            child_schema->format = "U";
+            private = csv__arrow_array_new(child, (int64_t)batch->rows, (int64_t)column->null_count, 3, 0);
+            private->buffers[1] = private->owned[1] = column->offsets;
+            private->buffers[2] = private->owned[2] = column->bytes;
+            column->offsets = NULL;
+            column->bytes = NULL;
+            column->bytes_capacity = 0;
+            break;
+        case CSV_COLUMN_STRING_VIEW:
+            // Views, then the data buffers (the parsed rows, not owned, and the unescaped items), then their sizes
+            child_schema->format = "vu";
+            private = csv__arrow_array_new(child, (int64_t)batch->rows, (int64_t)column->null_count, 5, 0);
+            private->buffers[1] = private->owned[1] = column->views;
+            private->buffers[2] = column->base;
+            private->buffers[3] = private->owned[2] = column->bytes;
+            private->variadic_sizes[0] = (int64_t)column->base_count;
+            private->variadic_sizes[1] = (int64_t)column->bytes_count;
+            private->buffers[4] = private->variadic_sizes;
+            column->views = NULL;
+            column->bytes = NULL;
+            column->bytes_capacity = 0;
+            break;
+        default:
             assert(0 && "unreachable");
         }
+        private->buffers[0] = private->owned[0] = column->validity;
+        column->validity = NULL;
+    }
+}
+
+static void csv__fill_field(char *out, Csv__Field field, Csv_String_View item) {
+    void *field_loc = out + field.offset;
+
+    static_assert(CSV_TYPE_COUNT == 4, "Exhaustive handling of supported types in csv__fill_field()");
+    switch (field.type) {
+    // Items that don't parse (or don't fit) are filled with 0
+    case CSV_TYPE_INT: {
+        int64_t parsed = 0;
+        if (csv_parse_i64(item, &parsed) != CSV_PARSE_OK || parsed < INT_MIN || parsed > INT_MAX) parsed = 0;
+        int val = (int)parsed;
+        memcpy(field_loc, &val, sizeof(val));
+    } break;
+    case CSV_TYPE_LONG: {
+        int64_t parsed = 0;
+        if (csv_parse_i64(item, &parsed) != CSV_PARSE_OK || parsed < LONG_MIN || parsed > LONG_MAX) parsed = 0;
+        long val = (long)parsed;
+        memcpy(field_loc, &val, sizeof(val));
+    } break;
+    case CSV_TYPE_FLOAT: {
+        double parsed = 0;
+        if (csv_parse_f64(item, &parsed) != CSV_PARSE_OK) parsed = 0;
+        float val = (float)parsed;
+        memcpy(field_loc, &val, sizeof(val));
+    } break;
+    case CSV_TYPE_STRING_VIEW: {
+        memcpy(field_loc, &item, sizeof(Csv_String_View));
+    } break;
+    default:
+        assert(0 && "unreachable");
+    }
+}
+
+void csv__fill_struct(void *out, Csv_String_View *row, Csv_Config config, const Csv__Field *fields, size_t fields_count) {
+    CSV__STAT_TIME(uint64_t start = csv__now_ns());
+    Csv_String_View item = {0};
+    for (size_t i = 0; i < fields_count && csv_next_item(row, &item, config); i++) {
+        csv__fill_field(out, fields[i], item);
+    }
+    CSV__STAT_TIME(csv__stats.fill_ns += csv__now_ns() - start);
+}
+
+void csv_schema_fill(const Csv_Schema *schema, Csv_String_View *row, Csv_Config config, void *out) {
+    csv__fill_struct(out, row, config, schema->fields, schema->count);
+}
+
+// FNV-1a
+static uint64_t csv__hash(Csv_String_View sv) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < csv_sv_count(sv); i++) {
+        hash ^= (unsigned char)csv_sv_data(sv)[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Most of the strings compared are short column names and values, where the call to memcmp() costs more than the compare.
+// Compares 16 bytes at a time, with the last 16 overlapping, and never reads past `count`.
+static bool csv__bytes_eq(const char *a, const char *b, size_t count) {
+#if defined(CSV__SSE2)
+    if (count >= 16) {
+        for (size_t i = 0; i + 16 < count; i += 16) {
+            __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(a + i)), _mm_loadu_si128((const __m128i *)(b + i)));
+            if (_mm_movemask_epi8(eq) != 0xFFFF) return false;
+        }
+        __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(a + count - 16)), _mm_loadu_si128((const __m128i *)(b + count - 16)));
+        return _mm_movemask_epi8(eq) == 0xFFFF;
+    }
+#endif // CSV__SSE2
+    if (count >= 8) {
+        uint64_t x, y, z, w;
+        memcpy(&x, a, 8); memcpy(&y, b, 8);
+        memcpy(&z, a + count - 8, 8); memcpy(&w, b + count - 8, 8);
+        if (count <= 16) return ((x ^ y) | (z ^ w)) == 0;
+        return memcmp(a, b, count) == 0;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (a[i] != b[i]) return false;
+    }
+    return true;
+}
+
+static bool csv__sv_eq(Csv_String_View a, Csv_String_View b) {
+    return csv_sv_count(a) == csv_sv_count(b) && csv__bytes_eq(csv_sv_data(a), csv_sv_data(b), csv_sv_count(a));
+}
+
+void csv_header_parse(Csv_Header *header, Csv_String_View row, Csv_Config config) {
+    header->count = 0;
+    csv_arena_reset(&header->arena);
+
+    Csv_Item item = {0};
+    while (csv_next_item_ex(&row, &item, config)) {
+        Csv_String_View name = csv_unescape(&header->arena, item, config);
+        if (!item.escaped) {
+            char *copy = csv_arena_alloc(&header->arena, csv_sv_count(name));
+            if (csv_sv_count(name) > 0) memcpy(copy, csv_sv_data(name), csv_sv_count(name));
+            name = csv_sv_from_parts(copy, csv_sv_count(name));
+        }
+        csv__da_append(header, name);
+    }
+
+    // At most half full, so probe sequences stay short
+    size_t slots_count = 16;
+    while (slots_count < header->count*2) slots_count *= 2;
+    if (slots_count != header->slots_count) {
+        header->slots = CSV_REALLOC(header->slots, slots_count*sizeof(*header->slots));
+        assert(header->slots != NULL && "Buy more RAM lol");
+        header->slots_count = slots_count;
+    }
+    memset(header->slots, 0, slots_count*sizeof(*header->slots));
+
+    assert(header->count < UINT32_MAX && "Too many columns");
+    for (size_t column = 0; column < header->count; column++) {
+        size_t slot = csv__hash(header->items[column]) & (slots_count - 1);
+        bool duplicate = false;
+        while (header->slots[slot] != 0 && !duplicate) {
+            duplicate = csv__sv_eq(header->items[header->slots[slot] - 1], header->items[column]);
+            slot = (slot + 1) & (slots_count - 1);
+        }
+        if (!duplicate) header->slots[slot] = (uint32_t)column + 1;
+    }
+}
+
+bool csv_header_find(const Csv_Header *header, Csv_String_View name, size_t *column) {
+    if (header->slots_count == 0) return false;
+    size_t slot = csv__hash(name) & (header->slots_count - 1);
+    while (header->slots[slot] != 0) {
+        size_t candidate = header->slots[slot] - 1;
+        if (csv__sv_eq(header->items[candidate], name)) {
+            *column = candidate;
+            return true;
+        }
+        slot = (slot + 1) & (header->slots_count - 1);
+    }
+    return false;
+}
+
+void csv_header_free(Csv_Header *header) {
+    CSV_FREE(header->items);
+    CSV_FREE(header->slots);
+    csv_arena_free(&header->arena);
+    memset(header, 0, sizeof(*header));
+}
+
+bool csv_schema_bind(const Csv_Schema *schema, const Csv_Header *header, Csv_Binding *binding) {
+    binding->fields = CSV_REALLOC(NULL, (schema->count > 0 ? schema->count : 1)*sizeof(*binding->fields));
+    binding->columns = CSV_REALLOC(NULL, (schema->count > 0 ? schema->count : 1)*sizeof(*binding->columns));
+    assert(binding->fields != NULL && binding->columns != NULL && "Buy more RAM lol");
+    binding->count = 0;
+
+    bool all_found = true;
+    for (size_t i = 0; i < schema->count; i++) {
+        Csv__Field field = schema->fields[i];
+        size_t column = 0;
+        if (field.name == NULL || !csv_header_find(header, csv_sv_from_parts((char *)field.name, strlen(field.name)), &column)) {
+            all_found = false;
+            continue;
+        }
+        // Insertion sort by column, schemas are small
+        size_t j = binding->count;
+        while (j > 0 && binding->columns[j - 1] > column) {
+            binding->fields[j] = binding->fields[j - 1];
+            binding->columns[j] = binding->columns[j - 1];
+            j -= 1;
+        }
+        binding->fields[j] = field;
+        binding->columns[j] = column;
+        binding->count += 1;
+    }
+    return all_found;
+}
+
+void csv_binding_fill(const Csv_Binding *binding, Csv_String_View *row, Csv_Config config, void *out) {
+    // Walk the row once, in column order, so it's the same work as filling by position
+    size_t column = 0;
+    Csv_String_View item = {0};
+    for (size_t i = 0; i < binding->count; i++) {
+        // Two fields can come from the same column
+        if (i == 0 || binding->columns[i] != binding->columns[i - 1]) {
+            csv_skip_items(row, binding->columns[i] - column, config);
+            if (!csv_next_item(row, &item, config)) return;
+            column = binding->columns[i] + 1;
+        }
+        csv__fill_field(out, binding->fields[i], item);
+    }
+}
+
+void csv_binding_free(Csv_Binding *binding) {
+    CSV_FREE(binding->fields);
+    CSV_FREE(binding->columns);
+    memset(binding, 0, sizeof(*binding));
+}
+
+bool csv_filter_init(Csv_Filter *filter, const Csv_Predicate *predicates, size_t count, const Csv_Header *header) {
+    filter->items = CSV_REALLOC(NULL, (count > 0 ? count : 1)*sizeof(*filter->items));
+    filter->text_counts = CSV_REALLOC(NULL, (count > 0 ? count : 1)*sizeof(*filter->text_counts));
+    assert(filter->items != NULL && filter->text_counts != NULL && "Buy more RAM lol");
+    filter->count = 0;
+
+    bool all_found = true;
+    for (size_t i = 0; i < count; i++) {
+        Csv_Predicate predicate = predicates[i];
+        if (predicate.name != NULL) {
+            size_t column = 0;
+            if (header == NULL || !csv_header_find(header, csv_sv_from_parts((char *)predicate.name, strlen(predicate.name)), &column)) {
+                // No such column, so no row can match
+                all_found = false;
+                column = SIZE_MAX;
+            }
+            predicate.column = column;
+        }
+        size_t text_count = predicate.text != NULL ? strlen(predicate.text) : 0;
+
+        // Insertion sort by column, filters are small
+        size_t j = filter->count;
+        while (j > 0 && filter->items[j - 1].column > predicate.column) {
+            filter->items[j] = filter->items[j - 1];
+            filter->text_counts[j] = filter->text_counts[j - 1];
+            j -= 1;
+        }
+        filter->items[j] = predicate;
+        filter->text_counts[j] = text_count;
+        filter->count += 1;
+    }
+    return all_found;
+}
+
+// Compares the unescaped bytes of `item` with `text`, without writing them anywhere
+static bool csv__unescaped_eq(Csv_String_View item, const char *text, size_t text_count, bool prefix, Csv_Config config) {
+    const char *data = csv_sv_data(item);
+    size_t count = csv_sv_count(item);
+    size_t j = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (data[i] == config.escape) {
+            i += 1;
+            if (i == count) break;
+        }
+        if (j == text_count) return prefix;
+        if (data[i] != text[j]) return false;
+        j += 1;
+    }
+    return j == text_count;
+}
+
+static bool csv__predicate_match(const Csv_Predicate *predicate, size_t text_count, Csv_Item item, Csv_Config config) {
+    switch (predicate->kind) {
+    case CSV_PREDICATE_EQ:
+        if (item.escaped) return csv__unescaped_eq(item.view, predicate->text, text_count, false, config);
+        return csv_sv_count(item.view) == text_count && csv__bytes_eq(csv_sv_data(item.view), predicate->text, text_count);
+    case CSV_PREDICATE_PREFIX:
+        if (item.escaped) return csv__unescaped_eq(item.view, predicate->text, text_count, true, config);
+        return csv_sv_count(item.view) >= text_count && csv__bytes_eq(csv_sv_data(item.view), predicate->text, text_count);
+    case CSV_PREDICATE_I64_RANGE: {
+        int64_t value = 0;
+        return csv_parse_i64(item.view, &value) == CSV_PARSE_OK && value >= predicate->i64.min && value <= predicate->i64.max;
+    }
+    case CSV_PREDICATE_F64_RANGE: {
+        double value = 0;
+        return csv_parse_f64(item.view, &value) == CSV_PARSE_OK && value >= predicate->f64.min && value <= predicate->f64.max;
+    }
+    default:
+        assert(0 && "unreachable");
+        return false;
+    }
+}
+
+// csv_next_item() stops at a trailing column delimiter instead of giving the empty item after it.
+// Tells whether `column` is that item, i.e. the row has exactly `column` items and then the delimiter.
+static bool csv__is_trailing_empty_item(Csv_String_View row, size_t column, Csv_Config config) {
+    size_t count = csv_sv_count(row);
+    if (count == 0 || csv_sv_data(row)[count - 1] != config.col_delim) return false;
+    size_t items = 0;
+    Csv_Item item = {0};
+    while (items <= column && csv_next_item_ex(&row, &item, config)) items += 1;
+    return items == column;
+}
+
+bool csv_filter_match(const Csv_Filter *filter, Csv_String_View row, Csv_Config config) {
+    // One pass over the row in column order, skipping the columns in between; the first predicate that fails ends it
+    Csv_String_View whole = row;
+    size_t column = 0;
+    Csv_Item item = {0};
+    for (size_t i = 0; i < filter->count; i++) {
+        const Csv_Predicate *predicate = &filter->items[i];
+        if (i == 0 || predicate->column != filter->items[i - 1].column) {
+            if (predicate->column == SIZE_MAX) return false;
+            csv_skip_items(&row, predicate->column - column, config);
+            if (!csv_next_item_ex(&row, &item, config)) {
+                if (!csv__is_trailing_empty_item(whole, predicate->column, config)) return false;
+                item = (Csv_Item) { .view = csv_sv_from_parts(csv_sv_data(row), 0) };
+            }
+            column = predicate->column + 1;
+        }
+        if (!csv__predicate_match(predicate, filter->text_counts[i], item, config)) return false;
+    }
+    return true;
+}
+
+bool csv_next_matching_row(Csv_String_View *file, Csv_String_View *row, const Csv_Filter *filter, Csv_Config config) {
+    while (csv_next_row(file, row, config)) {
+        if (csv_filter_match(filter, *row, config)) return true;
+    }
+    return false;
+}
+
+void csv_filter_free(Csv_Filter *filter) {
+    CSV_FREE(filter->items);
+    CSV_FREE(filter->text_counts);
+    memset(filter, 0, sizeof(*filter));
+}
+
+bool csv_sink_file(const char *data, size_t count, void *user) {
+    return fwrite(data, 1, count, (FILE *)user) == count;
+}
+
+void csv_writer_init(Csv_Writer *writer, Csv_Config config, Csv_Sink_Func sink, void *user) {
+    memset(writer, 0, sizeof(*writer));
+    writer->config = config;
+    writer->sink = sink;
+    writer->user = user;
+}
+
+bool csv_writer_flush(Csv_Writer *writer) {
+    if (writer->sink == NULL) return true;
+    if (writer->count > 0 && !writer->failed) {
+        writer->failed = !writer->sink(writer->items, writer->count, writer->user);
+    }
+    writer->count = 0;
+    return !writer->failed;
+}
+
+void csv_writer_free(Csv_Writer *writer) {
+    CSV_FREE(writer->items);
+    memset(writer, 0, sizeof(*writer));
+}
+
+// Makes room for `n` more bytes, flushing first if they don't fit. The buffer only grows past its size for huge items.
+static inline char *csv__writer_reserve(Csv_Writer *writer, size_t n) {
+    if (writer->count + n > writer->capacity && writer->sink == NULL) {
+        // Nowhere to flush to, keep everything
+        size_t capacity = writer->capacity == 0 ? CSV_WRITER_BUFFER_SIZE : writer->capacity*2;
+        while (capacity < writer->count + n) capacity *= 2;
+        writer->items = CSV_REALLOC(writer->items, capacity);
+        assert(writer->items != NULL && "Buy more RAM lol");
+        writer->capacity = capacity;
+    } else if (writer->count + n > writer->capacity) {
+        csv_writer_flush(writer);
+        if (n > writer->capacity) {
+            size_t capacity = n > CSV_WRITER_BUFFER_SIZE ? n : CSV_WRITER_BUFFER_SIZE;
+            CSV_FREE(writer->items);
+            writer->items = CSV_REALLOC(NULL, capacity);
+            assert(writer->items != NULL && "Buy more RAM lol");
+            writer->capacity = capacity;
+        }
+    }
+    return writer->items + writer->count;
+}
+
+static inline void csv__writer_separate(Csv_Writer *writer) {
+    if (writer->in_row) {
+        *csv__writer_reserve(writer, 1) = writer->config.col_delim;
+        writer->count += 1;
+    }
+    writer->in_row = true;
+    writer->empty_last = false;
+}
+
+// Bitmask of the bytes of a block that have to be escaped inside quotes, and of the ones that make quotes necessary
+static inline uint64_t csv__special_mask(const Csv__Block *masks, uint64_t *needs_quotes) {
+    *needs_quotes |= masks->quote | masks->escape | masks->row_delim | masks->col_delim;
+    return masks->quote | masks->escape;
+}
+
+// Writes `data` as the next item, with quotes and escapes where needed. The delimiter before it is already written.
+static void csv__write_text(Csv_Writer *writer, const char *data, size_t count) {
+    Csv_Config config = writer->config;
+
+    // Most items don't need quotes, which the same 64-byte classification as the parser tells at a glance
+    uint64_t needs_quotes = 0;
+    size_t specials = 0;
+    Csv__Block masks;
+    for (size_t i = 0; i < count; i += 64) {
+        size_t n = count - i < 64 ? count - i : 64;
+        if (n == 64) csv__classify_block(data + i, config, &masks);
+        else         csv__classify_tail(data + i, n, config, &masks);
+        specials += csv__popcount64(csv__special_mask(&masks, &needs_quotes));
+    }
+
+    if (needs_quotes == 0) {
+        char *out = csv__writer_reserve(writer, count);
+        if (count > 0) memcpy(out, data, count);
+        writer->count += count;
+        writer->empty_last = count == 0;
+        return;
+    }
+
+    // Quoted: runs between special bytes are copied as they are, and every special byte gets an escape in front
+    // (with doubled quotes the escape is the quote itself)
+    char *out = csv__writer_reserve(writer, count + specials + 2);
+    size_t written = 0;
+    out[written++] = config.quote;
+    for (size_t i = 0; i < count; i += 64) {
+        size_t n = count - i < 64 ? count - i : 64;
+        if (n == 64) csv__classify_block(data + i, config, &masks);
+        else         csv__classify_tail(data + i, n, config, &masks);
+        uint64_t special = csv__special_mask(&masks, &needs_quotes);
+        size_t copied = 0;
+        while (special != 0) {
+            size_t at = csv__ctz64(special);
+            memcpy(out + written, data + i + copied, at - copied);
+            written += at - copied;
+            out[written++] = config.escape;
+            out[written++] = data[i + at];
+            copied = at + 1;
+            special &= special - 1;
+        }
+        memcpy(out + written, data + i + copied, n - copied);
+        written += n - copied;
+    }
+    out[written++] = config.quote;
+    writer->count += written;
+}
+
+void csv_write_item(Csv_Writer *writer, Csv_String_View item) {
+    csv__writer_separate(writer);
+    csv__write_text(writer, csv_sv_data(item), csv_sv_count(item));
+}
+
+static const char csv__digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Number of decimal digits of `x`, from its bit length and one compare, without a loop
+static inline size_t csv__digit_count(uint64_t x) {
+    static const uint64_t powers[] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+        10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+        1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL,
+        10000000000000000000ULL,
+    };
+    // 0 has as many digits as 1, and 1233/4096 is just over log10(2)
+    x |= 1;
+    size_t digits = (64 - csv__clz64(x))*1233 >> 12;
+    return digits + (x >= powers[digits]);
+}
+
+// Writes the digits of `x` to `out` two at a time, from the end, and returns how many there are
+static inline size_t csv__format_u64(char *out, uint64_t x) {
+    size_t count = csv__digit_count(x);
+    char *p = out + count;
+    while (x >= 100) {
+        size_t pair = (size_t)(x%100)*2;
+        x /= 100;
+        p -= 2;
+        memcpy(p, csv__digit_pairs + pair, 2);
+    }
+    if (x >= 10) {
+        p -= 2;
+        memcpy(p, csv__digit_pairs + x*2, 2);
+    } else {
+        p[-1] = (char)('0' + x);
+    }
+    return count;
+}
+
+void csv_write_i64(Csv_Writer *writer, int64_t value) {
+    csv__writer_separate(writer);
+    char *out = csv__writer_reserve(writer, 20);
+    size_t written = 0;
+    uint64_t magnitude = (uint64_t)value;
+    if (value < 0) {
+        out[written++] = '-';
+        magnitude = 0 - magnitude;
+    }
+    written += csv__format_u64(out + written, magnitude);
+    writer->count += written;
+}
+
+// cp*g/2^127 rounded to odd, so the comparisons in csv__schubfach() come out as if they were exact
+static inline uint64_t csv__schubfach_rop(uint64_t g1, uint64_t g0, uint64_t cp) {
+    const uint64_t mask63 = ((uint64_t)1 << 63) - 1;
+    uint64_t x1, y1;
+    csv__mul128(g0, cp, &x1);
+    uint64_t y0 = csv__mul128(g1, cp, &y1);
+    uint64_t z = (y0 >> 1) + x1;
+    uint64_t vbp = y1 + (z >> 63);
+    return vbp | (((z & mask63) + mask63) >> 63);
+}
+
+// Schubfach by Raffaello Giulietti. Of the decimals that round to the positive double `bits`, returns one with the
+// fewest digits (the closest if there are several) as the digits and `*exponent` of digits*10^exponent.
+// The digits may end in zeros.
+static uint64_t csv__schubfach(uint64_t bits, int *exponent) {
+    const uint64_t hidden = (uint64_t)1 << 52;
+    const int q_min = -1074;
+    // The double is c*2^q
+    uint64_t c = bits & (hidden - 1);
+    int q = (int)(bits >> 52);
+    if (q != 0) {
+        c |= hidden;
+        q -= 1075;
+    } else {
+        q = q_min;
+    }
+
+    // The rounding interval is [cbl, cbr]*2^(q - 2), closed if c is even. It's lopsided at powers of two.
+    uint64_t out = c & 1;
+    uint64_t cb = c << 2;
+    uint64_t cbr = cb + 2;
+    uint64_t cbl;
+    int k;
+    if (c != hidden || q == q_min) {
+        cbl = cb - 2;
+        k = (int)(((int64_t)q*661971961083) >> 41);                  // floor(log10(2^q))
+    } else {
+        cbl = cb - 1;
+        k = (int)(((int64_t)q*661971961083 - 274743187321) >> 41);   // floor(log10(3/4*2^q))
+    }
+    int h = q + (int)(((int64_t)-k*913124641741) >> 38) + 2;         // floor(log2(10^-k))
+
+    // g is 10^-k in 126 bits, rounded up, from the top of 5^-k. The table rounds 5^-1 to 5^-27 up by one unit
+    // where it keeps all of their bits, which has to come off first.
+    const uint64_t *power = csv__powers_of_five[-k - CSV__POW5_MIN];
+    uint64_t high = power[0];
+    uint64_t low = power[1];
+    if (k >= 1 && k <= 27) {
+        if (low == 0) high -= 1;
+        low -= 1;
+    }
+    uint64_t g_high = high >> 2;
+    uint64_t g_low = (high << 62 | low >> 2) + 1;
+    if (g_low == 0) g_high += 1;
+    uint64_t g1 = g_high << 1 | g_low >> 63;
+    uint64_t g0 = g_low & (((uint64_t)1 << 63) - 1);
+
+    uint64_t vb  = csv__schubfach_rop(g1, g0, cb << h);
+    uint64_t vbl = csv__schubfach_rop(g1, g0, cbl << h);
+    uint64_t vbr = csv__schubfach_rop(g1, g0, cbr << h);
+
+    // One digit less than s, if a multiple of 10 is in the interval and the next one down or up isn't
+    uint64_t s = vb >> 2;
+    *exponent = k;
+    if (s >= 10) {
+        uint64_t sp10 = s/10*10;
+        uint64_t tp10 = sp10 + 10;
+        bool upin = vbl + out <= sp10 << 2;
+        bool wpin = (tp10 << 2) + out <= vbr;
+        if (upin != wpin) return upin ? sp10 : tp10;
+    }
+    // Otherwise s or s + 1, whichever is in the interval, or closer to the double if both are
+    uint64_t t = s + 1;
+    bool uin = vbl + out <= s << 2;
+    bool win = (t << 2) + out <= vbr;
+    if (uin != win) return uin ? s : t;
+    int64_t cmp = (int64_t)(vb - ((s + t) << 1));
+    return cmp < 0 || (cmp == 0 && (s & 1) == 0) ? s : t;
+}
+
+void csv_write_f64(Csv_Writer *writer, double value) {
+    csv__writer_separate(writer);
+    char *out = csv__writer_reserve(writer, 32);
+    size_t written = 0;
+
+    if (isnan(value)) {
+        memcpy(out, "nan", 3);
+        writer->count += 3;
+        return;
+    }
+    if (signbit(value)) {
+        out[written++] = '-';
+        value = -value;
+    }
+    if (isinf(value)) {
+        memcpy(out + written, "inf", 3);
+        writer->count += written + 3;
+        return;
+    }
+
+    // Most numbers in CSV have a few decimals. Find the fewest, k, for which the digits n = value*10^k give back
+    // exactly `value` when parsed: n and 10^k are exact doubles, so n/10^k is what csv_parse_f64() computes too.
+    // Below 2^50 the doubles around value*10^k are less than 1/4 apart, so at most one n gives `value` back, and
+    // rounding value*10^k finds it: that is the shortest and closest decimal, the same one csv__schubfach() gives.
+    const double max_scaled = 1125899906842624.0; // 2^50
+    if (value == 0 || value >= 1e-4) {
+        for (size_t k = 0; k <= 17 && value*csv__exact_powers[k] < max_scaled; k++) {
+            double scaled = value*csv__exact_powers[k];
+            uint64_t n = (uint64_t)(scaled + 0.5);
+            if ((double)n/csv__exact_powers[k] != value) continue;
+
+            char digits[20];
+            size_t count = csv__format_u64(digits, n);
+            if (count <= k) {
+                // 0.00ddd
+                memcpy(out + written, "0.", 2);
+                written += 2;
+                memset(out + written, '0', k - count);
+                written += k - count;
+                memcpy(out + written, digits, count);
+                written += count;
+            } else {
+                memcpy(out + written, digits, count - k);
+                written += count - k;
+                if (k > 0) {
+                    out[written++] = '.';
+                    memcpy(out + written, digits + count - k, k);
+                    written += k;
+                }
+            }
+            writer->count += written;
+            return;
+        }
+    }
+
+    // Tiny, huge, or too many digits for that
+    int exponent = 0;
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint64_t n = csv__schubfach(bits, &exponent);
+    // Short decimals come back with a lot of trailing zeros, so they come off 8, 4, 2 and 1 at a time
+    while (n%100000000 == 0) {
+        n /= 100000000;
+        exponent += 8;
+    }
+    if (n%10000 == 0) {
+        n /= 10000;
+        exponent += 4;
+    }
+    if (n%100 == 0) {
+        n /= 100;
+        exponent += 2;
+    }
+    if (n%10 == 0) {
+        n /= 10;
+        exponent += 1;
+    }
+    char digits[20];
+    int count = (int)csv__format_u64(digits, n);
+    int point = count + exponent; // Digits before the decimal point
+    if (point > 17 || point < -3) {
+        // d.ddde-x, like %g does past 17 digits or below 0.0001
+        out[written++] = digits[0];
+        if (count > 1) {
+            out[written++] = '.';
+            memcpy(out + written, digits + 1, count - 1);
+            written += count - 1;
+        }
+        out[written++] = 'e';
+        if (point - 1 < 0) out[written++] = '-';
+        written += csv__format_u64(out + written, (uint64_t)(point - 1 < 0 ? 1 - point : point - 1));
+    } else if (exponent >= 0) {
+        // ddd00
+        memcpy(out + written, digits, count);
+        memset(out + written + count, '0', exponent);
+        written += count + exponent;
+    } else if (point > 0) {
+        // dd.ddd
+        memcpy(out + written, digits, point);
+        out[written + point] = '.';
+        memcpy(out + written + point + 1, digits + point, count - point);
+        written += count + 1;
+    } else {
+        // 0.00ddd
+        memcpy(out + written, "0.", 2);
+        memset(out + written + 2, '0', -point);
+        memcpy(out + written + 2 - point, digits, count);
+        written += 2 - point + count;
+    }
+    writer->count += written;
+}
+
+void csv_end_row(Csv_Writer *writer) {
+    // A row that ends with an empty item (or is only one) would lose it on the way back, unless it's quoted
+    if (writer->empty_last) {
+        char *out = csv__writer_reserve(writer, 2);
+        out[0] = out[1] = writer->config.quote;
+        writer->count += 2;
+    }
+    *csv__writer_reserve(writer, 1) = writer->config.row_delim;
+    writer->count += 1;
+    writer->in_row = false;
+    writer->empty_last = false;
+}
+
+void csv_write_row(Csv_Writer *writer, const Csv_String_View *items, size_t count) {
+    for (size_t i = 0; i < count; i++) csv_write_item(writer, items[i]);
+    csv_end_row(writer);
+}
+
+// Appends output that is already formatted. Blocks bigger than the buffer go straight to the sink.
+static void csv__writer_append(Csv_Writer *writer, const char *data, size_t count) {
+    if (writer->sink != NULL && count > CSV_WRITER_BUFFER_SIZE) {
+        csv_writer_flush(writer);
+        if (!writer->failed) writer->failed = !writer->sink(data, count, writer->user);
+        return;
+    }
+    char *out = csv__writer_reserve(writer, count);
+    if (count > 0) memcpy(out, data, count);
+    writer->count += count;
+}
+
+typedef struct {
+    Csv_Writer *writer;
+    size_t rows;
+    Csv_Format_Func format;
+    void *user;
+    size_t next_batch;  // Sequence number of the next batch to format
+    size_t next_commit; // Sequence number of the next batch to pass on to `writer`
+#if defined(CSV__THREADS)
+    pthread_mutex_t lock;
+    pthread_cond_t committed;
+#endif // CSV__THREADS
+} Csv__Write_Pass;
+
+// Each thread takes the next batch, formats it into its own writer, waits until all the batches before it are
+// committed, and commits it. Batches are taken in order, so whoever holds the next one to commit is always running,
+// even when the tasks end up running one after the other.
+static void csv__write_task(size_t task, void *arg) {
+    (void)task;
+    Csv__Write_Pass *pass = arg;
+    Csv_Writer local = {0};
+    csv_writer_init(&local, pass->writer->config, NULL, NULL);
+
+    for (;;) {
+#if defined(CSV__THREADS)
+        pthread_mutex_lock(&pass->lock);
+#endif // CSV__THREADS
+        size_t batch = pass->next_batch++;
+#if defined(CSV__THREADS)
+        pthread_mutex_unlock(&pass->lock);
+#endif // CSV__THREADS
+        size_t first = batch*CSV_WRITE_BATCH_ROWS;
+        if (first >= pass->rows) break;
+        size_t count = pass->rows - first < CSV_WRITE_BATCH_ROWS ? pass->rows - first : CSV_WRITE_BATCH_ROWS;
+
+        local.count = 0;
+        local.in_row = false;
+        pass->format(&local, first, count, pass->user);
+
+#if defined(CSV__THREADS)
+        pthread_mutex_lock(&pass->lock);
+        while (pass->next_commit != batch) pthread_cond_wait(&pass->committed, &pass->lock);
+        pthread_mutex_unlock(&pass->lock);
+#endif // CSV__THREADS
+        // Only the holder of the next sequence number gets here, so `writer` needs no lock
+        csv__writer_append(pass->writer, local.items, local.count);
+#if defined(CSV__THREADS)
+        pthread_mutex_lock(&pass->lock);
+        pass->next_commit += 1;
+        pthread_cond_broadcast(&pass->committed);
+        pthread_mutex_unlock(&pass->lock);
+#else
+        pass->next_commit += 1;
+#endif // CSV__THREADS
     }
+
+    csv_writer_free(&local);
+}
+
+void csv_parallel_write(Csv_Writer *writer, size_t rows, size_t threads, Csv_Format_Func format, void *user) {
+    if (threads == 0) threads = csv__cpu_count();
+    size_t batches = (rows + CSV_WRITE_BATCH_ROWS - 1)/CSV_WRITE_BATCH_ROWS;
+    if (threads > batches) threads = batches;
+
+    Csv__Write_Pass pass = { .writer = writer, .rows = rows, .format = format, .user = user };
+#if defined(CSV__THREADS)
+    pthread_mutex_init(&pass.lock, NULL);
+    pthread_cond_init(&pass.committed, NULL);
+#endif // CSV__THREADS
+    csv__run_tasks(threads, csv__write_task, &pass);
+#if defined(CSV__THREADS)
+    pthread_mutex_destroy(&pass.lock);
+    pthread_cond_destroy(&pass.committed);
+#endif // CSV__THREADS
 }
 
 #endif // CSV_IMPLEMENTATION
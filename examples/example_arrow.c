@@ -0,0 +1,83 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+
+// A tiny Arrow consumer: only knows the C Data Interface, not csv.h
+bool arrow_is_valid(const struct ArrowArray *array, int64_t i) {
+    const uint8_t *validity = array->buffers[0];
+    return validity == NULL || (validity[i/8] >> i%8 & 1);
+}
+
+void arrow_print_value(const struct ArrowSchema *schema, const struct ArrowArray *array, int64_t i) {
+    if (!arrow_is_valid(array, i)) {
+        printf("null");
+    } else if (strcmp(schema->format, "l") == 0) {
+        printf("%lld", (long long)((const int64_t *)array->buffers[1])[i]);
+    } else if (strcmp(schema->format, "g") == 0) {
+        printf("%.2f", ((const double *)array->buffers[1])[i]);
+    } else if (strcmp(schema->format, "U") == 0) {
+        const int64_t *offsets = array->buffers[1];
+        const char *data = array->buffers[2];
+        printf("\"%.*s\"", (int)(offsets[i + 1] - offsets[i]), data + offsets[i]);
+    } else if (strcmp(schema->format, "vu") == 0) {
+        const uint8_t *view = (const uint8_t *)array->buffers[1] + 16*i;
+        int32_t length, buffer, offset;
+        memcpy(&length, view, 4);
+        if (length <= 12) {
+            printf("\"%.*s\"", (int)length, (const char *)view + 4);
+        } else {
+            memcpy(&buffer, view + 8, 4);
+            memcpy(&offset, view + 12, 4);
+            const char *data = array->buffers[2 + buffer];
+            printf("\"%.*s\"", (int)length, data + offset);
+        }
+    } else {
+        printf("<%s>", schema->format);
+    }
+}
+
+int main(void) {
+    const char *path = "examples/test_floats.csv";
+    Csv_File f = {0};
+    if (!csv_file_open(&f, path)) {
+        fprintf(stderr, "ERROR: Could not read file %s: %s\n", path, strerror(errno));
+        return 1;
+    }
+
+    Csv_Column_Type types[] = { CSV_COLUMN_F64, CSV_COLUMN_I64, CSV_COLUMN_STRING_VIEW, CSV_COLUMN_STRING };
+    size_t sources[]        = { 0,              1,              3,                      2                 };
+    const char *names[]     = { "a",            "b",            "name",                 "c_text"          };
+    Csv_Batch batch = {0};
+    csv_batch_init(&batch, types, sources, 4, 4);
+
+    Csv_String_View file = f.data;
+    while (csv_batch_read(&batch, &file, csv_default_config) > 0) {
+        struct ArrowSchema schema;
+        struct ArrowArray array;
+        csv_batch_export_arrow(&batch, names, &schema, &array);
+
+        printf("Batch of %lld rows (%s)\n", (long long)array.length, schema.format);
+        for (int64_t i = 0; i < array.length; i++) {
+            printf("  {");
+            for (int64_t j = 0; j < schema.n_children; j++) {
+                printf("%s%s: ", j > 0 ? ", " : "", schema.children[j]->name);
+                arrow_print_value(schema.children[j], array.children[j], i);
+            }
+            printf("}\n");
+        }
+
+        // What an Arrow consumer does once it's done with the data
+        array.release(&array);
+        schema.release(&schema);
+    }
+
+    csv_batch_free(&batch);
+    csv_file_close(&f);
+    return 0;
+}
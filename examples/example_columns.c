@@ -0,0 +1,44 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+
+int main(void) {
+    const char *path = "examples/test_floats.csv";
+    Csv_File f = {0};
+    if (!csv_file_open(&f, path)) {
+        fprintf(stderr, "ERROR: Could not read file %s: %s\n", path, strerror(errno));
+        return 1;
+    }
+
+    // Columns a, c and name of test_floats.csv, 4 rows at a time
+    Csv_Column_Type types[] = { CSV_COLUMN_F64, CSV_COLUMN_F64, CSV_COLUMN_STRING };
+    size_t sources[]        = { 0,              2,              3                 };
+    Csv_Batch batch = {0};
+    csv_batch_init(&batch, types, sources, 3, 4);
+
+    double sum_a = 0, sum_c = 0;
+    size_t rows = 0, names_bytes = 0;
+    Csv_String_View file = f.data;
+    while (csv_batch_read(&batch, &file, csv_default_config) > 0) {
+        // Plain loops over contiguous arrays, easy for the compiler to vectorize
+        const double *a = batch.columns[0].f64;
+        const double *c = batch.columns[1].f64;
+        for (size_t i = 0; i < batch.rows; i++) {
+            sum_a += a[i];
+            sum_c += c[i];
+        }
+        names_bytes += batch.columns[2].bytes_count;
+        rows += batch.rows;
+    }
+    printf("%zu rows: sum(a) = %.2f, sum(c) = %.2f, %zu bytes of names\n", rows, sum_a, sum_c, names_bytes);
+
+    csv_batch_free(&batch);
+    csv_file_close(&f);
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#define NOB_IMPLEMENTATION
+#define NOB_STRIP_PREFIX
+#include "nob.h"
+
+#define Csv_String_View Nob_String_View
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+
+int main(void) {
+    const char *path = "examples/test_filter.csv";
+    Csv_File f = {0};
+    if (!csv_file_open(&f, path)) {
+        nob_log(ERROR, "Could not read file %s: %s", path, strerror(errno));
+        return 1;
+    }
+    String_View file = f.data;
+
+    String_View row = {0};
+    if (!csv_next_row(&file, &row, csv_default_config)) {
+        nob_log(ERROR, "%s is empty", path);
+        return 1;
+    }
+    Csv_Header header = {0};
+    csv_header_parse(&header, row, csv_default_config);
+
+    // Failed jobs of at least 10 that nobody left a note on. The note is the last column, so an empty one is just a
+    // trailing comma, and it still counts as "".
+    Csv_Predicate predicates[] = {
+        { .kind = CSV_PREDICATE_EQ, .name = "status", .text = "FAILED" },
+        { .kind = CSV_PREDICATE_F64_RANGE, .name = "amount", .f64 = { 10, INFINITY } },
+        { .kind = CSV_PREDICATE_EQ, .name = "note", .text = "" },
+    };
+    Csv_Filter filter = {0};
+    if (!csv_filter_init(&filter, predicates, ARRAY_LEN(predicates), &header)) {
+        nob_log(ERROR, "Some predicates have no column in %s", path);
+        return 1;
+    }
+
+    size_t matched = 0;
+    while (csv_next_matching_row(&file, &row, &filter, csv_default_config)) {
+        nob_log(INFO, "Unexplained failure: "SV_Fmt, SV_Arg(row));
+        matched += 1;
+    }
+    // Only job 6: job 3 is too small, jobs 1 and 4 have notes
+    assert(matched == 1);
+
+    csv_filter_free(&filter);
+    csv_header_free(&header);
+    csv_file_close(&f);
+
+    return 0;
+}
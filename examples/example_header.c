@@ -0,0 +1,58 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+
+#define NOB_IMPLEMENTATION
+#define NOB_STRIP_PREFIX
+#include "nob.h"
+
+#define Csv_String_View Nob_String_View
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+
+typedef struct {
+    float a;
+    float b;
+    float c;
+    String_View name;
+} Entry;
+
+int main(void) {
+    // Same data as test_floats.csv, but with a header and the columns in another order
+    const char *path = "examples/test_header.csv";
+    Csv_File f = {0};
+    if (!csv_file_open(&f, path)) {
+        nob_log(ERROR, "Could not read file %s: %s", path, strerror(errno));
+        return 1;
+    }
+    String_View file = f.data;
+
+    String_View row = {0};
+    if (!csv_next_row(&file, &row, csv_default_config)) {
+        nob_log(ERROR, "%s is empty", path);
+        return 1;
+    }
+    Csv_Header header = {0};
+    csv_header_parse(&header, row, csv_default_config);
+
+    Csv_Schema schema = CSV_SCHEMA(Entry, CSVF(a), CSVF(b), CSVF(c), CSVF(name));
+    Csv_Binding binding = {0};
+    if (!csv_schema_bind(&schema, &header, &binding)) {
+        nob_log(WARNING, "Some fields of Entry have no column in %s", path);
+    }
+
+    while (csv_next_row(&file, &row, csv_default_config)) {
+        Entry entry = {0};
+        csv_binding_fill(&binding, &row, csv_default_config, &entry);
+        nob_log(INFO, "%.2f * %.2f = %.2f (discovered by "SV_Fmt")", entry.a, entry.b, entry.c, SV_Arg(entry.name));
+    }
+
+    csv_binding_free(&binding);
+    csv_header_free(&header);
+    csv_file_close(&f);
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+
+bool sv_eq_cstr(Csv_String_View sv, const char *cstr) {
+    return sv.count == strlen(cstr) && memcmp(sv.data, cstr, sv.count) == 0;
+}
+
+int main(void) {
+    // Quotes only ever start an item, and close right before a delimiter: every parser path agrees on files like that
+    const char *path = "examples/test_quotes.csv";
+    Csv_File f = {0};
+    if (!csv_file_open(&f, path)) {
+        fprintf(stderr, "ERROR: Could not read file %s: %s\n", path, strerror(errno));
+        return 1;
+    }
+
+    Csv_String_View file = f.data;
+    Csv_String_View row = {0};
+    Csv_Arena arena = {0};
+    size_t rows = 0;
+    while (csv_next_row(&file, &row, csv_default_config)) {
+        // Skipping the first two items lands where reading them does
+        Csv_String_View skipped = row;
+        csv_skip_items(&skipped, 2, csv_default_config);
+
+        Csv_Item item = {0};
+        size_t items = 0;
+        while (csv_next_item_ex(&row, &item, csv_default_config)) {
+            Csv_String_View sv = csv_unescape(&arena, item, csv_default_config);
+            printf("Item: %.*s\n", (int)sv.count, sv.data);
+            if (rows == 1 && items == 2) assert(sv_eq_cstr(sv, "said \"hi\""));
+            if (rows == 3 && items == 1) assert(item.quoted && sv.count == 0);
+            items += 1;
+            if (items == 2) assert(row.data == skipped.data && row.count == skipped.count);
+        }
+        assert(items == 3);
+        rows += 1;
+    }
+    assert(rows == 5);
+    assert(csv_count_rows(f.data, csv_default_config) == rows);
+
+    csv_arena_free(&arena);
+    csv_file_close(&f);
+    return 0;
+}
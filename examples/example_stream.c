@@ -0,0 +1,44 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+
+void print_row(Csv_String_View row, void *user) {
+    (void)user;
+    printf("New Row\n");
+    Csv_String_View item = {0};
+    while (csv_next_item(&row, &item, csv_default_config)) {
+        printf("Item: %.*s\n", (int)item.count, item.data);
+    }
+}
+
+int main(void) {
+    const char *path = "examples/test.csv";
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "ERROR: Could not open file %s: %s\n", path, strerror(errno));
+        return 1;
+    }
+
+    // A tiny buffer on purpose, so most rows and quoted fields are split between reads
+    char buffer[7];
+    Csv_Stream stream = {0};
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+        csv_stream_feed(&stream, buffer, n, csv_default_config, print_row, NULL);
+    }
+    csv_stream_finish(&stream, print_row, NULL);
+    csv_stream_free(&stream);
+
+    if (ferror(f)) {
+        fprintf(stderr, "ERROR: Could not read file %s: %s\n", path, strerror(errno));
+        fclose(f);
+        return 1;
+    }
+    fclose(f);
+    return 0;
+}
@@ -26,9 +26,13 @@ typedef struct {
 } Entries;
 
 int main(void) {
-    String_Builder sb = {0};
-    if (!read_entire_file("examples/test_floats.csv", &sb)) return 1;
-    String_View file = sb_to_sv(sb);
+    const char *path = "examples/test_floats.csv";
+    Csv_File f = {0};
+    if (!csv_file_open(&f, path)) {
+        nob_log(ERROR, "Could not read file %s: %s", path, strerror(errno));
+        return 1;
+    }
+    String_View file = f.data;
 
     Entries entries = {0};
 
@@ -38,6 +42,7 @@ int main(void) {
         CSV_FILL_STRUCT(row, csv_default_config, entry, CSVF(a), CSVF(b), CSVF(c), CSVF(name));
 
         da_append(&entries, entry);
+        csv_file_advance(&f, file.data);
     }
 
     for (size_t i = 0; i < entries.count; i++) {
@@ -45,5 +50,7 @@ int main(void) {
         nob_log(INFO, "%.2f * %.2f = %.2f (discovered by "SV_Fmt")", entry.a, entry.b, entry.c, SV_Arg(entry.name));
     }
 
+    csv_file_close(&f);
+
     return 0;
 }
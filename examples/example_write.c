@@ -0,0 +1,58 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define CSV_IMPLEMENTATION
+#include "csv.h"
+
+#define ARRAY_LEN(array) (sizeof(array)/sizeof(*(array)))
+
+// Rows with empty items in every position, and items that need quotes and escapes
+const char *rows[][3] = {
+    { "",      "middle", "last" },
+    { "first", "",       "last" },
+    { "first", "middle", ""     },
+    { "",      "",       ""     },
+    { "a,b",   "say \"hi\"", "two\nlines" },
+};
+
+int main(void) {
+    // Without a sink, everything stays in writer.items
+    Csv_Writer writer = {0};
+    csv_writer_init(&writer, csv_default_config, NULL, NULL);
+    for (size_t i = 0; i < ARRAY_LEN(rows); i++) {
+        for (size_t j = 0; j < ARRAY_LEN(rows[i]); j++) {
+            csv_write_item(&writer, csv_sv_from_parts((char *)rows[i][j], strlen(rows[i][j])));
+        }
+        csv_end_row(&writer);
+    }
+    // An empty row with a single empty item
+    csv_write_item(&writer, csv_sv_from_parts("", 0));
+    csv_end_row(&writer);
+    printf("%.*s", (int)writer.count, writer.items);
+
+    // Reading it back gives the same items
+    Csv_String_View file = csv_sv_from_parts(writer.items, writer.count);
+    Csv_String_View row = {0};
+    Csv_Arena arena = {0};
+    size_t i = 0;
+    while (csv_next_row(&file, &row, csv_default_config)) {
+        Csv_Item item = {0};
+        size_t j = 0;
+        while (csv_next_item_ex(&row, &item, csv_default_config)) {
+            Csv_String_View sv = csv_unescape(&arena, item, csv_default_config);
+            const char *expected = i < ARRAY_LEN(rows) ? rows[i][j] : "";
+            assert(sv.count == strlen(expected) && memcmp(sv.data, expected, sv.count) == 0);
+            j += 1;
+        }
+        assert(j == (i < ARRAY_LEN(rows) ? ARRAY_LEN(rows[i]) : 1));
+        i += 1;
+    }
+    assert(i == ARRAY_LEN(rows) + 1);
+
+    csv_arena_free(&arena);
+    csv_writer_free(&writer);
+    return 0;
+}
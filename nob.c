@@ -17,9 +17,46 @@ defer:
     return result;
 }
 
+bool build_bench(const char *src_path, const char *dst_path, char **cflags, int cflags_count) {
+    bool result = true;
+
+    Cmd cmd = {0};
+    cmd_append(&cmd, "cc", "-Wall", "-Wextra", "-O3", "-pthread");
+    cmd_append(&cmd, "-I.");
+    cmd_append(&cmd, "-o", dst_path);
+    cmd_append(&cmd, src_path);
+    da_append_many(&cmd, cflags, cflags_count);
+    if (!cmd_run_sync_and_reset(&cmd)) return_defer(false);
+
+defer:
+    free(cmd.items);
+    return result;
+}
+
+const char *benches[] = {
+    "bench_delim",
+    "bench_rows",
+    "bench_parallel",
+    "bench_fill",
+    "bench_numbers",
+    "bench_unescape",
+    "bench_projection",
+    "bench_filter",
+    "bench_row_index",
+    "bench_writer",
+    "bench_suite",
+};
+
 const char *examples[] = {
     "example_basic",
     "example_struct",
+    "example_stream",
+    "example_columns",
+    "example_arrow",
+    "example_header",
+    "example_filter",
+    "example_quotes",
+    "example_write",
 };
 
 int main(int argc, char **argv) {
@@ -37,6 +74,30 @@ int main(int argc, char **argv) {
     if (argc == 0) return 0;
 
     const char *arg = shift_args(&argc, &argv);
+    if (strcmp(arg, "bench") == 0) {
+        // Anything after `bench` is passed to the compiler, e.g. `./nob bench -march=native`
+        for (size_t i = 0; i < ARRAY_LEN(benches); i++) {
+            const char *bench = benches[i];
+            if (!build_bench(temp_sprintf("bench/%s.c", bench), temp_sprintf("build/%s", bench), argv, argc)) return 1;
+        }
+        for (size_t i = 0; i < ARRAY_LEN(benches); i++) {
+            Cmd cmd = {0};
+            cmd_append(&cmd, temp_sprintf("build/%s", benches[i]));
+            if (!cmd_run_sync_and_reset(&cmd)) return 1;
+        }
+        return 0;
+    }
+
+    if (strcmp(arg, "gen") == 0) {
+        // Anything after `gen` is passed to the generator, e.g. `./nob gen --size=4G --seed=7 build/big.csv`
+        if (!build_bench("bench/gen_dataset.c", "build/gen_dataset", NULL, 0)) return 1;
+        Cmd cmd = {0};
+        cmd_append(&cmd, "build/gen_dataset");
+        da_append_many(&cmd, argv, argc);
+        if (!cmd_run_sync_and_reset(&cmd)) return 1;
+        return 0;
+    }
+
     for (size_t i = 0; i < ARRAY_LEN(examples); i++) {
         const char *example = examples[i];
         if (strcmp(example, arg) == 0) {